@@ -42,10 +42,17 @@ public class Dreamer : ModuleRules
                 "EditorStyle",
                 "SourceControl",
                 "ToolMenus",
+                "DirectoryWatcher",
                 // ... add private dependencies that you statically link with here ...                
             }
         );
         
+        // Live Coding is used for fast iteration where the target supports it
+        if (Target.bWithLiveCoding)
+        {
+            PrivateDependencyModuleNames.Add("LiveCoding");
+        }
+
         DynamicallyLoadedModuleNames.AddRange(
             new string[]
             {
@@ -7,17 +7,276 @@
 #include "Widgets/Images/SImage.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Input/SSearchBox.h"
 #include "Widgets/Views/SHeaderRow.h"
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Layout/SBox.h"
 #include "Framework/Commands/UIAction.h"
 #include "Framework/Commands/UICommandList.h"
+#include "Async/Async.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Fonts/FontMeasure.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
 #include "DreamerModule.h"
 
 #define LOCTEXT_NAMESPACE "BuildErrorList"
 
+namespace BuildErrorListColumns
+{
+    static const FName Severity("Severity");
+    static const FName Code("Code");
+    static const FName Description("Description");
+    static const FName File("File");
+    static const FName Line("Line");
+}
+
+namespace
+{
+    /** Compares two messages by a single column, returns <0, 0 or >0 */
+    int32 CompareByColumn(const FBuildError& A, const FBuildError& B, const FName& ColumnId)
+    {
+        if (ColumnId == BuildErrorListColumns::Severity)
+        {
+            return static_cast<int32>(A.GetSeverity()) - static_cast<int32>(B.GetSeverity());
+        }
+        else if (ColumnId == BuildErrorListColumns::Code)
+        {
+            return A.GetCode().Compare(B.GetCode(), ESearchCase::IgnoreCase);
+        }
+        else if (ColumnId == BuildErrorListColumns::Description)
+        {
+            return A.GetMessage().Compare(B.GetMessage(), ESearchCase::IgnoreCase);
+        }
+        else if (ColumnId == BuildErrorListColumns::File)
+        {
+            return A.GetFilePath().Compare(B.GetFilePath(), ESearchCase::IgnoreCase);
+        }
+        else if (ColumnId == BuildErrorListColumns::Line)
+        {
+            return A.GetLineNumber() != B.GetLineNumber()
+                ? A.GetLineNumber() - B.GetLineNumber()
+                : A.GetColumnNumber() - B.GetColumnNumber();
+        }
+
+        return 0;
+    }
+
+    /** Applies a sort direction to a column comparison result */
+    int32 ApplySortMode(int32 Result, EColumnSortMode::Type SortMode)
+    {
+        return SortMode == EColumnSortMode::Descending ? -Result : Result;
+    }
+}
+
+namespace BuildErrorListLayout
+{
+    /** Initial column widths of the header row. Rows read the current widths from the header. */
+    static const float SeverityWidth = 24.0f;
+    static const float CodeWidth = 70.0f;
+    static const float LineWidth = 60.0f;
+
+    /** Initial fill coefficients of the stretching columns */
+    static const float DescriptionFill = 0.5f;
+    static const float FileFill = 0.3f;
+
+    static const float RowHeight = 24.0f;
+    static const float IconSize = 16.0f;
+    static const float CellPadding = 4.0f;
+}
+
+/**
+ * Lightweight row for the build error list. Rather than building a widget per cell, it paints the icon and
+ * the pre-formatted cell strings from the record's display cache directly.
+ */
+class SBuildErrorRow : public STableRow<TSharedPtr<FBuildError>>
+{
+public:
+    SLATE_BEGIN_ARGS(SBuildErrorRow)
+        : _TextHeight(0.0f)
+    {}
+        SLATE_ARGUMENT(FSlateFontInfo, Font)
+        SLATE_ARGUMENT(float, TextHeight)
+        SLATE_ARGUMENT(TSharedPtr<SHeaderRow>, HeaderRow)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable, const TSharedRef<FBuildError>& InError, const TSharedRef<const FBuildErrorRowCache>& InCache)
+    {
+        Error = InError;
+        Cache = InCache;
+        Font = InArgs._Font;
+        TextHeight = InArgs._TextHeight;
+        HeaderRow = InArgs._HeaderRow;
+
+        STableRow<TSharedPtr<FBuildError>>::Construct(STableRow<TSharedPtr<FBuildError>>::FArguments(), InOwnerTable);
+
+        // The full path is only turned into text when the tooltip is actually shown
+        SetToolTipText(TAttribute<FText>::CreateSP(this, &SBuildErrorRow::GetFilePathToolTip));
+    }
+
+    virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override
+    {
+        using namespace BuildErrorListLayout;
+
+        // Selection and hover background
+        LayerId = STableRow<TSharedPtr<FBuildError>>::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+        const FBuildErrorRowCache& RowCache = *Cache;
+        const FVector2D Size = AllottedGeometry.GetLocalSize();
+        const float TextY = (static_cast<float>(Size.Y) - TextHeight) * 0.5f;
+        const FLinearColor TintColor = InWidgetStyle.GetColorAndOpacityTint();
+
+        TArray<FCellLayout, TInlineAllocator<5>> Cells;
+        GetCellLayout(static_cast<float>(Size.X), Cells);
+
+        ++LayerId;
+
+        float X = 0.0f;
+        for (const FCellLayout& Cell : Cells)
+        {
+            if (Cell.ColumnId == BuildErrorListColumns::Severity)
+            {
+                if (RowCache.Icon)
+                {
+                    FSlateDrawElement::MakeBox(
+                        OutDrawElements,
+                        LayerId,
+                        AllottedGeometry.ToPaintGeometry(FVector2D(IconSize, IconSize), FSlateLayoutTransform(FVector2D(X + (Cell.Width - IconSize) * 0.5f, (Size.Y - IconSize) * 0.5f))),
+                        RowCache.Icon,
+                        ESlateDrawEffect::None,
+                        RowCache.TextColor * TintColor);
+                }
+            }
+            else if (Cell.ColumnId == BuildErrorListColumns::Code)
+            {
+                PaintCell(AllottedGeometry, OutDrawElements, LayerId, X, TextY, Cell.Width, Error->GetCode(), FLinearColor::White * TintColor);
+            }
+            else if (Cell.ColumnId == BuildErrorListColumns::Description)
+            {
+                PaintCell(AllottedGeometry, OutDrawElements, LayerId, X, TextY, Cell.Width, Error->GetMessage(), RowCache.TextColor * TintColor);
+            }
+            else if (Cell.ColumnId == BuildErrorListColumns::File)
+            {
+                PaintCell(AllottedGeometry, OutDrawElements, LayerId, X, TextY, Cell.Width, RowCache.FileName, FLinearColor::White * TintColor);
+            }
+            else if (Cell.ColumnId == BuildErrorListColumns::Line)
+            {
+                PaintCell(AllottedGeometry, OutDrawElements, LayerId, X, TextY, Cell.Width, RowCache.LineText, FLinearColor::White * TintColor);
+            }
+
+            X += Cell.Width;
+        }
+
+        return LayerId;
+    }
+
+    virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override
+    {
+        return FVector2D(0.0f, BuildErrorListLayout::RowHeight);
+    }
+
+private:
+    /** Column and width of one cell */
+    struct FCellLayout
+    {
+        FName ColumnId;
+        float Width;
+    };
+
+    /**
+     * Lays out the header columns over the row width the way the header does, so cells stay aligned with
+     * columns after they are resized.
+     */
+    void GetCellLayout(float RowWidth, TArray<FCellLayout, TInlineAllocator<5>>& OutCells) const
+    {
+        using namespace BuildErrorListLayout;
+
+        const TSharedPtr<SHeaderRow> Header = HeaderRow.Pin();
+        if (!Header.IsValid())
+        {
+            const float FillWidth = FMath::Max(0.0f, RowWidth - SeverityWidth - CodeWidth - LineWidth);
+            const float DescriptionWidth = FillWidth * DescriptionFill / (DescriptionFill + FileFill);
+            OutCells.Add({ BuildErrorListColumns::Severity, SeverityWidth });
+            OutCells.Add({ BuildErrorListColumns::Code, CodeWidth });
+            OutCells.Add({ BuildErrorListColumns::Description, DescriptionWidth });
+            OutCells.Add({ BuildErrorListColumns::File, FillWidth - DescriptionWidth });
+            OutCells.Add({ BuildErrorListColumns::Line, LineWidth });
+            return;
+        }
+
+        // Fixed and manually sized columns take their widths, fill columns share the rest by their coefficients
+        float SizedWidth = 0.0f;
+        float TotalFill = 0.0f;
+        for (const SHeaderRow::FColumn& Column : Header->GetColumns())
+        {
+            if (Column.SizeRule == EColumnSizeMode::Fill)
+            {
+                TotalFill += Column.GetWidth();
+            }
+            else
+            {
+                SizedWidth += Column.GetWidth();
+            }
+        }
+
+        const float FillWidth = FMath::Max(0.0f, RowWidth - SizedWidth);
+        for (const SHeaderRow::FColumn& Column : Header->GetColumns())
+        {
+            const float Width = Column.SizeRule != EColumnSizeMode::Fill ? Column.GetWidth()
+                : (TotalFill > 0.0f ? FillWidth * Column.GetWidth() / TotalFill : 0.0f);
+            OutCells.Add({ Column.ColumnId, Width });
+        }
+    }
+
+    /** Paints a single clipped line of text into a cell */
+    void PaintCell(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId, float X, float TextY, float Width, const FString& Text, const FLinearColor& Color) const
+    {
+        using namespace BuildErrorListLayout;
+
+        const float TextWidth = Width - 2.0f * CellPadding;
+        if (Text.IsEmpty() || TextWidth <= 0.0f)
+        {
+            return;
+        }
+
+        const FPaintGeometry CellGeometry = AllottedGeometry.ToPaintGeometry(FVector2D(TextWidth, TextHeight), FSlateLayoutTransform(FVector2D(X + CellPadding, TextY)));
+
+        OutDrawElements.PushClip(FSlateClippingZone(CellGeometry));
+        FSlateDrawElement::MakeText(OutDrawElements, LayerId, CellGeometry, Text, Font, ESlateDrawEffect::None, Color);
+        OutDrawElements.PopClip();
+    }
+
+    FText GetFilePathToolTip() const
+    {
+        return FText::FromString(Error->GetFilePath());
+    }
+
+    /** The record this row shows */
+    TSharedPtr<FBuildError> Error;
+
+    /** Pre-formatted display data for the record */
+    TSharedPtr<const FBuildErrorRowCache> Cache;
+
+    /** Header whose current column widths the cells follow */
+    TWeakPtr<SHeaderRow> HeaderRow;
+
+    /** Font used for all cells, and its line height */
+    FSlateFontInfo Font;
+    float TextHeight = 0.0f;
+};
+
 void SBuildErrorList::Construct(const FArguments& InArgs)
 {
+    // Default order: errors first, then by file, then by line
+    Query.PrimarySortColumn = BuildErrorListColumns::Severity;
+    Query.PrimarySortMode = EColumnSortMode::Descending;
+    Query.SecondarySortColumn = BuildErrorListColumns::File;
+    Query.SecondarySortMode = EColumnSortMode::Ascending;
+
+    RowFont = FCoreStyle::GetDefaultFontStyle("Regular", 9);
+    RowTextHeight = FSlateApplication::Get().GetRenderer()->GetFontMeasureService()->GetMaxCharacterHeight(RowFont);
+
     ChildSlot
     [
         SNew(SBorder)
@@ -45,11 +304,89 @@ void SBuildErrorList::Construct(const FArguments& InArgs)
                     .OnClicked(this, &SBuildErrorList::OnClearAllClicked)
                 ]
 
-                // Filter options will go here in the future
+                // Severity filters
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                .Padding(4.0f, 0.0f)
+                [
+                    SNew(SCheckBox)
+                    .Style(FEditorStyle::Get(), "ToggleButtonCheckbox")
+                    .IsChecked(this, &SBuildErrorList::IsSeverityShown, EBuildMessageSeverity::Error)
+                    .OnCheckStateChanged(this, &SBuildErrorList::OnSeverityFilterChanged, EBuildMessageSeverity::Error)
+                    .ToolTipText(LOCTEXT("ShowErrorsTooltip", "Show errors"))
+                    [
+                        SNew(STextBlock)
+                        .Text(LOCTEXT("ShowErrors", "Errors"))
+                    ]
+                ]
+
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                .Padding(4.0f, 0.0f)
+                [
+                    SNew(SCheckBox)
+                    .Style(FEditorStyle::Get(), "ToggleButtonCheckbox")
+                    .IsChecked(this, &SBuildErrorList::IsSeverityShown, EBuildMessageSeverity::Warning)
+                    .OnCheckStateChanged(this, &SBuildErrorList::OnSeverityFilterChanged, EBuildMessageSeverity::Warning)
+                    .ToolTipText(LOCTEXT("ShowWarningsTooltip", "Show warnings"))
+                    [
+                        SNew(STextBlock)
+                        .Text(LOCTEXT("ShowWarnings", "Warnings"))
+                    ]
+                ]
+
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                .Padding(4.0f, 0.0f)
+                [
+                    SNew(SCheckBox)
+                    .Style(FEditorStyle::Get(), "ToggleButtonCheckbox")
+                    .IsChecked(this, &SBuildErrorList::IsSeverityShown, EBuildMessageSeverity::Info)
+                    .OnCheckStateChanged(this, &SBuildErrorList::OnSeverityFilterChanged, EBuildMessageSeverity::Info)
+                    .ToolTipText(LOCTEXT("ShowInfosTooltip", "Show informational messages"))
+                    [
+                        SNew(STextBlock)
+                        .Text(LOCTEXT("ShowInfos", "Messages"))
+                    ]
+                ]
+
+                // Text filters
+                + SHorizontalBox::Slot()
+                .FillWidth(0.4f)
+                .VAlign(VAlign_Center)
+                .Padding(4.0f, 0.0f)
+                [
+                    SNew(SSearchBox)
+                    .HintText(LOCTEXT("TextFilterHint", "Search messages..."))
+                    .OnTextChanged(this, &SBuildErrorList::OnTextFilterChanged)
+                ]
+
+                + SHorizontalBox::Slot()
+                .FillWidth(0.2f)
+                .VAlign(VAlign_Center)
+                .Padding(4.0f, 0.0f)
+                [
+                    SNew(SSearchBox)
+                    .HintText(LOCTEXT("FileFilterHint", "File..."))
+                    .OnTextChanged(this, &SBuildErrorList::OnFileFilterChanged)
+                ]
+
+                + SHorizontalBox::Slot()
+                .FillWidth(0.1f)
+                .VAlign(VAlign_Center)
+                .Padding(4.0f, 0.0f)
+                [
+                    SNew(SSearchBox)
+                    .HintText(LOCTEXT("CodeFilterHint", "Code..."))
+                    .OnTextChanged(this, &SBuildErrorList::OnCodeFilterChanged)
+                ]
 
                 // Message count
                 + SHorizontalBox::Slot()
-                .FillWidth(1.0f)
+                .AutoWidth()
                 .HAlign(HAlign_Right)
                 .VAlign(VAlign_Center)
                 .Padding(4.0f, 0.0f, 0.0f, 0.0f)
@@ -64,34 +401,54 @@ void SBuildErrorList::Construct(const FArguments& InArgs)
             .FillHeight(1.0f)
             [
                 SAssignNew(ErrorListView, SListView<TSharedPtr<FBuildError>>)
-                .ItemHeight(24.0f)
-                .ListItemsSource(&AllMessages)
+                .ItemHeight(BuildErrorListLayout::RowHeight)
+                .ListItemsSource(&VisibleMessages)
                 .OnGenerateRow(this, &SBuildErrorList::OnGenerateRow)
                 .OnSelectionChanged(this, &SBuildErrorList::OnErrorSelected)
                 .SelectionMode(ESelectionMode::Single)
                 .HeaderRow
                 (
-                    SNew(SHeaderRow)
-                    
+                    SAssignNew(HeaderRow, SHeaderRow)
+
                     // Severity column
-                    + SHeaderRow::Column("Severity")
+                    + SHeaderRow::Column(BuildErrorListColumns::Severity)
                     .DefaultLabel(LOCTEXT("SeverityColumn", ""))
-                    .FixedWidth(24.0f)
-                    
+                    .FixedWidth(BuildErrorListLayout::SeverityWidth)
+                    .SortMode(this, &SBuildErrorList::GetColumnSortMode, BuildErrorListColumns::Severity)
+                    .SortPriority(this, &SBuildErrorList::GetColumnSortPriority, BuildErrorListColumns::Severity)
+                    .OnSort(this, &SBuildErrorList::OnColumnSortModeChanged)
+
+                    // Code column
+                    + SHeaderRow::Column(BuildErrorListColumns::Code)
+                    .DefaultLabel(LOCTEXT("CodeColumn", "Code"))
+                    .FixedWidth(BuildErrorListLayout::CodeWidth)
+                    .SortMode(this, &SBuildErrorList::GetColumnSortMode, BuildErrorListColumns::Code)
+                    .SortPriority(this, &SBuildErrorList::GetColumnSortPriority, BuildErrorListColumns::Code)
+                    .OnSort(this, &SBuildErrorList::OnColumnSortModeChanged)
+
                     // Description column
-                    + SHeaderRow::Column("Description")
+                    + SHeaderRow::Column(BuildErrorListColumns::Description)
                     .DefaultLabel(LOCTEXT("DescriptionColumn", "Description"))
-                    .FillWidth(0.5f)
-                    
+                    .FillWidth(BuildErrorListLayout::DescriptionFill)
+                    .SortMode(this, &SBuildErrorList::GetColumnSortMode, BuildErrorListColumns::Description)
+                    .SortPriority(this, &SBuildErrorList::GetColumnSortPriority, BuildErrorListColumns::Description)
+                    .OnSort(this, &SBuildErrorList::OnColumnSortModeChanged)
+
                     // File column
-                    + SHeaderRow::Column("File")
+                    + SHeaderRow::Column(BuildErrorListColumns::File)
                     .DefaultLabel(LOCTEXT("FileColumn", "File"))
-                    .FillWidth(0.3f)
-                    
+                    .FillWidth(BuildErrorListLayout::FileFill)
+                    .SortMode(this, &SBuildErrorList::GetColumnSortMode, BuildErrorListColumns::File)
+                    .SortPriority(this, &SBuildErrorList::GetColumnSortPriority, BuildErrorListColumns::File)
+                    .OnSort(this, &SBuildErrorList::OnColumnSortModeChanged)
+
                     // Line column
-                    + SHeaderRow::Column("Line")
+                    + SHeaderRow::Column(BuildErrorListColumns::Line)
                     .DefaultLabel(LOCTEXT("LineColumn", "Line"))
-                    .FixedWidth(60.0f)
+                    .FixedWidth(BuildErrorListLayout::LineWidth)
+                    .SortMode(this, &SBuildErrorList::GetColumnSortMode, BuildErrorListColumns::Line)
+                    .SortPriority(this, &SBuildErrorList::GetColumnSortPriority, BuildErrorListColumns::Line)
+                    .OnSort(this, &SBuildErrorList::OnColumnSortModeChanged)
                 )
             ]
         ]
@@ -100,77 +457,260 @@ void SBuildErrorList::Construct(const FArguments& InArgs)
 
 void SBuildErrorList::SetErrors(const TArray<TSharedPtr<FBuildError>>& InErrors)
 {
-    // Remove old errors from the list
-    AllMessages.RemoveAll([](TSharedPtr<FBuildError> Error) { 
-        return Error->GetSeverity() == EBuildMessageSeverity::Error; 
-    });
+    ReplaceMessages(EBuildMessageSeverity::Error, InErrors);
+}
+
+void SBuildErrorList::SetWarnings(const TArray<TSharedPtr<FBuildError>>& InWarnings)
+{
+    ReplaceMessages(EBuildMessageSeverity::Warning, InWarnings);
+}
+
+void SBuildErrorList::ClearAll()
+{
+    AllMessages = MakeShared<const TArray<TSharedPtr<FBuildError>>>();
+    RowCaches.Reset();
+    ErrorCount = 0;
+    WarningCount = 0;
+
+    // Invalidate any filter pass still in flight and clear the view right away
+    CompletedFilterGeneration = ++FilterGeneration;
+    VisibleMessages.Empty();
+
+    // Refresh the list view
+    if (ErrorListView.IsValid())
+    {
+        ErrorListView->RequestListRefresh();
+    }
+}
 
-    // Add new errors
-    AllMessages.Append(InErrors);
+void SBuildErrorList::RunScrollBenchmark(int32 NumMessages)
+{
+    if (ScrollBenchmark.IsSet())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("A build error list scroll benchmark is already running"));
+        return;
+    }
+
+    TArray<TSharedPtr<FBuildError>> Errors;
+    TArray<TSharedPtr<FBuildError>> Warnings;
+    for (int32 Index = 0; Index < NumMessages; ++Index)
+    {
+        const bool bIsError = (Index % 4) == 0;
+        TSharedPtr<FBuildError> Message = MakeShared<FBuildError>(
+            FString::Printf(TEXT("Synthetic diagnostic %d: use of undeclared identifier 'Value%d'"), Index, Index),
+            FString::Printf(TEXT("Source/Benchmark/Private/BenchmarkFile%d.cpp"), Index % 500),
+            Index % 2000 + 1,
+            Index % 80,
+            bIsError ? EBuildMessageSeverity::Error : EBuildMessageSeverity::Warning,
+            FString::Printf(TEXT("C%04d"), Index % 5000));
+
+        (bIsError ? Errors : Warnings).Add(Message);
+    }
+
+    SetErrors(Errors);
+    SetWarnings(Warnings);
+
+    ScrollBenchmark.Emplace();
+    RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SBuildErrorList::TickScrollBenchmark));
+}
+
+EActiveTimerReturnType SBuildErrorList::TickScrollBenchmark(double InCurrentTime, float InDeltaTime)
+{
+    if (!ScrollBenchmark.IsSet() || !ErrorListView.IsValid())
+    {
+        ScrollBenchmark.Reset();
+        return EActiveTimerReturnType::Stop;
+    }
 
-    // Sort messages (errors first, then by file, then by line)
-    AllMessages.Sort([](const TSharedPtr<FBuildError>& A, const TSharedPtr<FBuildError>& B) {
-        // Sort by severity first
-        if (A->GetSeverity() != B->GetSeverity())
+    FScrollBenchmark& Benchmark = ScrollBenchmark.GetValue();
+
+    // Wait for the filter pass over the synthetic messages to land
+    if (!Benchmark.bStarted)
+    {
+        if (CompletedFilterGeneration != FilterGeneration)
         {
-            return A->GetSeverity() > B->GetSeverity(); // Errors before warnings
+            return EActiveTimerReturnType::Continue;
         }
 
-        // Then by file
-        if (A->GetFilePath() != B->GetFilePath())
+        ErrorListView->ScrollToTop();
+        Benchmark.bStarted = true;
+        Benchmark.LastFrameTime = FPlatformTime::Seconds();
+        Benchmark.StartRowCount = GeneratedRowCount;
+        return EActiveTimerReturnType::Continue;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    const double FrameTime = Now - Benchmark.LastFrameTime;
+    Benchmark.LastFrameTime = Now;
+    Benchmark.TotalFrameTime += FrameTime;
+    Benchmark.MaxFrameTime = FMath::Max(Benchmark.MaxFrameTime, FrameTime);
+    Benchmark.NumFrames++;
+
+    // Scroll by a full page so every frame has to generate a fresh set of rows
+    Benchmark.ScrollOffset += FMath::Max(1, ErrorListView->GetNumLiveWidgets());
+    if (Benchmark.ScrollOffset < VisibleMessages.Num())
+    {
+        ErrorListView->SetScrollOffset(Benchmark.ScrollOffset);
+        return EActiveTimerReturnType::Continue;
+    }
+
+    const int32 RowsGenerated = GeneratedRowCount - Benchmark.StartRowCount;
+    UE_LOG(LogTemp, Display, TEXT("Build error list scroll benchmark: %d messages, %d frames, avg %.3f ms, max %.3f ms, %d rows generated (%.1f per frame)"),
+        VisibleMessages.Num(),
+        Benchmark.NumFrames,
+        Benchmark.NumFrames > 0 ? Benchmark.TotalFrameTime * 1000.0 / Benchmark.NumFrames : 0.0,
+        Benchmark.MaxFrameTime * 1000.0,
+        RowsGenerated,
+        Benchmark.NumFrames > 0 ? static_cast<float>(RowsGenerated) / Benchmark.NumFrames : 0.0f);
+
+    ScrollBenchmark.Reset();
+    return EActiveTimerReturnType::Stop;
+}
+
+void SBuildErrorList::ReplaceMessages(EBuildMessageSeverity Severity, const TArray<TSharedPtr<FBuildError>>& InMessages)
+{
+    // Build a new message list rather than modifying the current one, which may be in use by a filter pass.
+    // Only the shared pointers are copied, never the records themselves.
+    TSharedRef<TArray<TSharedPtr<FBuildError>>> NewMessages = MakeShared<TArray<TSharedPtr<FBuildError>>>();
+    NewMessages->Reserve(AllMessages->Num() + InMessages.Num());
+
+    for (const TSharedPtr<FBuildError>& Message : *AllMessages)
+    {
+        if (Message->GetSeverity() != Severity)
         {
-            return A->GetFilePath() < B->GetFilePath();
+            NewMessages->Add(Message);
         }
+    }
 
-        // Then by line
-        return A->GetLineNumber() < B->GetLineNumber();
-    });
+    NewMessages->Append(InMessages);
 
-    // Refresh the list view
-    if (ErrorListView.IsValid())
+    ErrorCount = 0;
+    WarningCount = 0;
+    for (const TSharedPtr<FBuildError>& Message : *NewMessages)
     {
-        ErrorListView->RequestListRefresh();
+        if (Message->GetSeverity() == EBuildMessageSeverity::Error)
+        {
+            ErrorCount++;
+        }
+        else if (Message->GetSeverity() == EBuildMessageSeverity::Warning)
+        {
+            WarningCount++;
+        }
     }
+
+    AllMessages = NewMessages;
+    RowCaches.Reset();
+    RequestFilterRefresh();
 }
 
-void SBuildErrorList::SetWarnings(const TArray<TSharedPtr<FBuildError>>& InWarnings)
+void SBuildErrorList::RequestFilterRefresh()
 {
-    // Remove old warnings from the list
-    AllMessages.RemoveAll([](TSharedPtr<FBuildError> Error) { 
-        return Error->GetSeverity() == EBuildMessageSeverity::Warning; 
+    const int32 Generation = ++FilterGeneration;
+    TSharedRef<const TArray<TSharedPtr<FBuildError>>> Messages = AllMessages;
+    TWeakPtr<SBuildErrorList> WeakThis = StaticCastSharedRef<SBuildErrorList>(AsShared());
+
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, Generation, Messages, QueryCopy = Query]()
+    {
+        const TArray<int32> Indices = BuildVisibleIndices(*Messages, QueryCopy);
+
+        TArray<TSharedPtr<FBuildError>> Result;
+        Result.Reserve(Indices.Num());
+        for (int32 Index : Indices)
+        {
+            Result.Add((*Messages)[Index]);
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Generation, Result = MoveTemp(Result)]() mutable
+        {
+            if (TSharedPtr<SBuildErrorList> This = WeakThis.Pin())
+            {
+                This->OnFilterRefreshCompleted(Generation, MoveTemp(Result));
+            }
+        });
     });
+}
 
-    // Add new warnings
-    AllMessages.Append(InWarnings);
+TArray<int32> SBuildErrorList::BuildVisibleIndices(const TArray<TSharedPtr<FBuildError>>& Messages, const FBuildErrorListQuery& InQuery)
+{
+    TArray<int32> Indices;
+    Indices.Reserve(Messages.Num());
 
-    // Sort messages (errors first, then by file, then by line)
-    AllMessages.Sort([](const TSharedPtr<FBuildError>& A, const TSharedPtr<FBuildError>& B) {
-        // Sort by severity first
-        if (A->GetSeverity() != B->GetSeverity())
+    for (int32 Index = 0; Index < Messages.Num(); ++Index)
+    {
+        const FBuildError& Message = *Messages[Index];
+
+        switch (Message.GetSeverity())
         {
-            return A->GetSeverity() > B->GetSeverity(); // Errors before warnings
+        case EBuildMessageSeverity::Error:
+            if (!InQuery.bShowErrors) { continue; }
+            break;
+        case EBuildMessageSeverity::Warning:
+            if (!InQuery.bShowWarnings) { continue; }
+            break;
+        default:
+            if (!InQuery.bShowInfos) { continue; }
+            break;
         }
 
-        // Then by file
-        if (A->GetFilePath() != B->GetFilePath())
+        if (!InQuery.TextFilter.IsEmpty() && !Message.GetMessage().Contains(InQuery.TextFilter))
         {
-            return A->GetFilePath() < B->GetFilePath();
+            continue;
         }
 
-        // Then by line
-        return A->GetLineNumber() < B->GetLineNumber();
-    });
+        if (!InQuery.FileFilter.IsEmpty() && !Message.GetFilePath().Contains(InQuery.FileFilter))
+        {
+            continue;
+        }
 
-    // Refresh the list view
-    if (ErrorListView.IsValid())
-    {
-        ErrorListView->RequestListRefresh();
+        if (!InQuery.CodeFilter.IsEmpty() && !Message.GetCode().Contains(InQuery.CodeFilter))
+        {
+            continue;
+        }
+
+        Indices.Add(Index);
     }
+
+    Indices.Sort([&Messages, &InQuery](int32 IndexA, int32 IndexB)
+    {
+        const FBuildError& A = *Messages[IndexA];
+        const FBuildError& B = *Messages[IndexB];
+
+        if (InQuery.PrimarySortMode != EColumnSortMode::None)
+        {
+            const int32 Result = ApplySortMode(CompareByColumn(A, B, InQuery.PrimarySortColumn), InQuery.PrimarySortMode);
+            if (Result != 0)
+            {
+                return Result < 0;
+            }
+        }
+
+        if (InQuery.SecondarySortMode != EColumnSortMode::None)
+        {
+            const int32 Result = ApplySortMode(CompareByColumn(A, B, InQuery.SecondarySortColumn), InQuery.SecondarySortMode);
+            if (Result != 0)
+            {
+                return Result < 0;
+            }
+        }
+
+        // Then by line, and finally by arrival order so the result is stable
+        const int32 LineResult = CompareByColumn(A, B, BuildErrorListColumns::Line);
+        return LineResult != 0 ? LineResult < 0 : IndexA < IndexB;
+    });
+
+    return Indices;
 }
 
-void SBuildErrorList::ClearAll()
+void SBuildErrorList::OnFilterRefreshCompleted(int32 Generation, TArray<TSharedPtr<FBuildError>>&& InVisibleMessages)
 {
-    AllMessages.Empty();
+    // A newer request supersedes this result
+    if (Generation != FilterGeneration)
+    {
+        return;
+    }
+
+    VisibleMessages = MoveTemp(InVisibleMessages);
+    CompletedFilterGeneration = Generation;
 
     // Refresh the list view
     if (ErrorListView.IsValid())
@@ -187,20 +727,14 @@ FReply SBuildErrorList::OnClearAllClicked()
 
 FText SBuildErrorList::GetMessageCountText() const
 {
-    int32 ErrorCount = 0;
-    int32 WarningCount = 0;
-
-    // Count errors and warnings
-    for (const TSharedPtr<FBuildError>& Message : AllMessages)
+    if (VisibleMessages.Num() != AllMessages->Num())
     {
-        if (Message->GetSeverity() == EBuildMessageSeverity::Error)
-        {
-            ErrorCount++;
-        }
-        else if (Message->GetSeverity() == EBuildMessageSeverity::Warning)
-        {
-            WarningCount++;
-        }
+        return FText::Format(
+            LOCTEXT("FilteredMessageCount", "{0} error(s), {1} warning(s) ({2} shown)"),
+            FText::AsNumber(ErrorCount),
+            FText::AsNumber(WarningCount),
+            FText::AsNumber(VisibleMessages.Num())
+        );
     }
 
     return FText::Format(
@@ -210,6 +744,113 @@ FText SBuildErrorList::GetMessageCountText() const
     );
 }
 
+ECheckBoxState SBuildErrorList::IsSeverityShown(EBuildMessageSeverity Severity) const
+{
+    bool bShown = false;
+    switch (Severity)
+    {
+    case EBuildMessageSeverity::Error:
+        bShown = Query.bShowErrors;
+        break;
+    case EBuildMessageSeverity::Warning:
+        bShown = Query.bShowWarnings;
+        break;
+    default:
+        bShown = Query.bShowInfos;
+        break;
+    }
+
+    return bShown ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
+void SBuildErrorList::OnSeverityFilterChanged(ECheckBoxState NewState, EBuildMessageSeverity Severity)
+{
+    const bool bShown = NewState == ECheckBoxState::Checked;
+    switch (Severity)
+    {
+    case EBuildMessageSeverity::Error:
+        Query.bShowErrors = bShown;
+        break;
+    case EBuildMessageSeverity::Warning:
+        Query.bShowWarnings = bShown;
+        break;
+    default:
+        Query.bShowInfos = bShown;
+        break;
+    }
+
+    RequestFilterRefresh();
+}
+
+void SBuildErrorList::OnTextFilterChanged(const FText& InText)
+{
+    Query.TextFilter = InText.ToString();
+    RequestFilterRefresh();
+}
+
+void SBuildErrorList::OnFileFilterChanged(const FText& InText)
+{
+    Query.FileFilter = InText.ToString();
+    RequestFilterRefresh();
+}
+
+void SBuildErrorList::OnCodeFilterChanged(const FText& InText)
+{
+    Query.CodeFilter = InText.ToString();
+    RequestFilterRefresh();
+}
+
+EColumnSortMode::Type SBuildErrorList::GetColumnSortMode(const FName ColumnId) const
+{
+    if (ColumnId == Query.PrimarySortColumn)
+    {
+        return Query.PrimarySortMode;
+    }
+    else if (ColumnId == Query.SecondarySortColumn)
+    {
+        return Query.SecondarySortMode;
+    }
+
+    return EColumnSortMode::None;
+}
+
+EColumnSortPriority::Type SBuildErrorList::GetColumnSortPriority(const FName ColumnId) const
+{
+    if (ColumnId == Query.PrimarySortColumn)
+    {
+        return EColumnSortPriority::Primary;
+    }
+    else if (ColumnId == Query.SecondarySortColumn)
+    {
+        return EColumnSortPriority::Secondary;
+    }
+
+    return EColumnSortPriority::Max;
+}
+
+void SBuildErrorList::OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type InSortMode)
+{
+    // Shift-click on a header adds a secondary sort, a plain click replaces the primary one
+    if (SortPriority == EColumnSortPriority::Primary)
+    {
+        Query.PrimarySortColumn = ColumnId;
+        Query.PrimarySortMode = InSortMode;
+
+        if (ColumnId == Query.SecondarySortColumn)
+        {
+            Query.SecondarySortColumn = NAME_None;
+            Query.SecondarySortMode = EColumnSortMode::None;
+        }
+    }
+    else if (SortPriority == EColumnSortPriority::Secondary)
+    {
+        Query.SecondarySortColumn = ColumnId;
+        Query.SecondarySortMode = InSortMode;
+    }
+
+    RequestFilterRefresh();
+}
+
 void SBuildErrorList::OnErrorSelected(TSharedPtr<FBuildError> InError, ESelectInfo::Type SelectType)
 {
     if (!InError.IsValid())
@@ -217,69 +858,53 @@ void SBuildErrorList::OnErrorSelected(TSharedPtr<FBuildError> InError, ESelectIn
         return;
     }
 
-    // Get the file path and line number
-    FString FilePath = InError->GetFilePath();
-    int32 LineNumber = InError->GetLineNumber();
-
-    // Notify the module to open the file at the specified location
+    // Notify the module to open the file at the specified location. Keyboard navigation only updates the editor,
+    // so that the list keeps focus (and stays visible if it shares a dock stack with the editor) while stepping through it.
+    const bool bActivate = SelectType != ESelectInfo::OnNavigation && SelectType != ESelectInfo::OnKeyPress;
     FDreamerModule& DreamerModule = FModuleManager::GetModuleChecked<FDreamerModule>("Dreamer");
-    DreamerModule.OpenFileAtLocation(FilePath, LineNumber);
+    DreamerModule.OpenFileAtLocation(InError->GetFilePath(), InError->GetLineNumber(), InError->GetColumnNumber(), bActivate);
+
+    // Warm up the files of the next few messages so stepping through the list does not wait on disk
+    const int32 SelectedIndex = VisibleMessages.Find(InError);
+    if (SelectedIndex != INDEX_NONE)
+    {
+        TArray<FString> FilesToPrefetch;
+        const int32 EndIndex = FMath::Min(VisibleMessages.Num(), SelectedIndex + 1 + NumPrefetchedMessages);
+        for (int32 Index = SelectedIndex + 1; Index < EndIndex; ++Index)
+        {
+            FilesToPrefetch.AddUnique(VisibleMessages[Index]->GetFilePath());
+        }
+
+        DreamerModule.PrefetchFiles(FilesToPrefetch);
+    }
 }
 
 TSharedRef<ITableRow> SBuildErrorList::OnGenerateRow(TSharedPtr<FBuildError> InError, const TSharedRef<STableViewBase>& OwnerTable)
 {
-    return SNew(STableRow<TSharedPtr<FBuildError>>, OwnerTable)
-        [
-            SNew(SHorizontalBox)
-
-            // Severity icon
-            + SHorizontalBox::Slot()
-            .AutoWidth()
-            .HAlign(HAlign_Center)
-            .VAlign(VAlign_Center)
-            .Padding(4.0f, 0.0f)
-            [
-                SNew(SImage)
-                .Image(GetSeverityIcon(InError))
-                .ColorAndOpacity(GetErrorTextColor(InError))
-            ]
+    ++GeneratedRowCount;
+    return SNew(SBuildErrorRow, OwnerTable, InError.ToSharedRef(), GetRowCache(InError))
+        .Font(RowFont)
+        .TextHeight(RowTextHeight)
+        .HeaderRow(HeaderRow);
+}
 
-            // Description
-            + SHorizontalBox::Slot()
-            .FillWidth(0.5f)
-            .VAlign(VAlign_Center)
-            .Padding(4.0f, 0.0f)
-            [
-                SNew(STextBlock)
-                .Text(FText::FromString(InError->GetMessage()))
-                .ColorAndOpacity(GetErrorTextColor(InError))
-            ]
+TSharedRef<const FBuildErrorRowCache> SBuildErrorList::GetRowCache(const TSharedPtr<FBuildError>& InError)
+{
+    if (const TSharedRef<const FBuildErrorRowCache>* Existing = RowCaches.Find(InError.Get()))
+    {
+        return *Existing;
+    }
 
-            // File
-            + SHorizontalBox::Slot()
-            .FillWidth(0.3f)
-            .VAlign(VAlign_Center)
-            .Padding(4.0f, 0.0f)
-            [
-                SNew(STextBlock)
-                .Text(FText::FromString(FPaths::GetCleanFilename(InError->GetFilePath())))
-                .ToolTipText(FText::FromString(InError->GetFilePath()))
-            ]
+    TSharedRef<FBuildErrorRowCache> Cache = MakeShared<FBuildErrorRowCache>();
+    Cache->FileName = FPaths::GetCleanFilename(InError->GetFilePath());
+    Cache->LineText = InError->GetColumnNumber() > 0
+        ? FString::Printf(TEXT("%d:%d"), InError->GetLineNumber(), InError->GetColumnNumber())
+        : FString::FromInt(InError->GetLineNumber());
+    Cache->Icon = GetSeverityIcon(InError);
+    Cache->TextColor = GetErrorTextColor(InError).GetSpecifiedColor();
 
-            // Line
-            + SHorizontalBox::Slot()
-            .AutoWidth()
-            .VAlign(VAlign_Center)
-            .Padding(4.0f, 0.0f)
-            [
-                SNew(SBox)
-                .WidthOverride(60.0f)
-                [
-                    SNew(STextBlock)
-                    .Text(FText::AsNumber(InError->GetLineNumber()))
-                ]
-            ]
-        ];
+    RowCaches.Add(InError.Get(), Cache);
+    return Cache;
 }
 
 FSlateColor SBuildErrorList::GetErrorTextColor(TSharedPtr<FBuildError> InError) const
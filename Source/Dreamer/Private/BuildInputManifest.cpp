@@ -0,0 +1,275 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BuildInputManifest.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+
+FBuildInputManifest::~FBuildInputManifest()
+{
+    Shutdown();
+}
+
+void FBuildInputManifest::Initialize(const TArray<FString>& InRootDirectories, const TArray<FString>& InExtraFiles)
+{
+    RootDirectories = InRootDirectories;
+    ExtraFiles = InExtraFiles;
+
+    // Watch before the initial pass so edits made while it runs are not missed
+    FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+    if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get())
+    {
+        for (const FString& RootDirectory : RootDirectories)
+        {
+            if (!IFileManager::Get().DirectoryExists(*RootDirectory))
+            {
+                continue;
+            }
+
+            FDelegateHandle Handle;
+            DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(
+                RootDirectory,
+                IDirectoryWatcher::FDirectoryChanged::CreateSP(this, &FBuildInputManifest::OnDirectoryChanged),
+                Handle);
+            WatcherHandles.Emplace(RootDirectory, Handle);
+        }
+    }
+
+    TWeakPtr<FBuildInputManifest> WeakThis = AsShared();
+    InitialPass = Async(EAsyncExecution::ThreadPool, [WeakThis]()
+    {
+        if (TSharedPtr<FBuildInputManifest> This = WeakThis.Pin())
+        {
+            This->HashFiles(This->FindBuildInputs());
+        }
+    });
+}
+
+void FBuildInputManifest::Shutdown()
+{
+    if (WatcherHandles.Num() > 0)
+    {
+        if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+        {
+            if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+            {
+                for (const TPair<FString, FDelegateHandle>& WatcherHandle : WatcherHandles)
+                {
+                    DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatcherHandle.Key, WatcherHandle.Value);
+                }
+            }
+        }
+
+        WatcherHandles.Empty();
+    }
+
+    if (InitialPass.IsValid())
+    {
+        InitialPass.Wait();
+    }
+}
+
+bool FBuildInputManifest::IsReady() const
+{
+    return InitialPass.IsValid() && InitialPass.IsReady();
+}
+
+bool FBuildInputManifest::ComputeHash(FXxHash64& OutHash)
+{
+    if (!IsReady())
+    {
+        return false;
+    }
+
+    // Deliver any change notifications the watcher has queued but not dispatched yet
+    if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+    {
+        if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+        {
+            DirectoryWatcher->Tick(0.0f);
+        }
+    }
+
+    TArray<FString> FilesToHash;
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (bRescanRequired)
+        {
+            bRescanRequired = false;
+            DirtyFiles.Empty();
+            FileHashes.Empty();
+        }
+        else
+        {
+            FilesToHash = DirtyFiles.Array();
+            DirtyFiles.Empty();
+        }
+    }
+
+    if (FilesToHash.Num() > 0 || GetNumFiles() == 0)
+    {
+        HashFiles(FilesToHash.Num() > 0 ? FilesToHash : FindBuildInputs());
+    }
+
+    FXxHash64Builder Builder;
+    {
+        FScopeLock ScopeLock(&Lock);
+
+        // Combine in a stable order, so the result only depends on paths and contents
+        TArray<FString> SortedPaths;
+        FileHashes.GetKeys(SortedPaths);
+        SortedPaths.Sort();
+
+        for (const FString& FilePath : SortedPaths)
+        {
+            const FXxHash64 FileHash = FileHashes.FindChecked(FilePath);
+            Builder.Update(*FilePath, FilePath.Len() * sizeof(TCHAR));
+            Builder.Update(&FileHash.Hash, sizeof(FileHash.Hash));
+        }
+    }
+
+    for (const FString& ExtraFile : ExtraFiles)
+    {
+        const FXxHash64 FileHash = HashFile(ExtraFile);
+        Builder.Update(*ExtraFile, ExtraFile.Len() * sizeof(TCHAR));
+        Builder.Update(&FileHash.Hash, sizeof(FileHash.Hash));
+    }
+
+    OutHash = Builder.Finalize();
+    return true;
+}
+
+int32 FBuildInputManifest::GetNumFiles() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return FileHashes.Num();
+}
+
+bool FBuildInputManifest::IsBuildInput(const FString& FilePath)
+{
+    // Generated code and build products change with every build without being inputs to it
+    if (FilePath.Contains(TEXT("/Intermediate/")) || FilePath.Contains(TEXT("/Binaries/")))
+    {
+        return false;
+    }
+
+    return FilePath.EndsWith(TEXT(".h"))
+        || FilePath.EndsWith(TEXT(".hpp"))
+        || FilePath.EndsWith(TEXT(".inl"))
+        || FilePath.EndsWith(TEXT(".cpp"))
+        || FilePath.EndsWith(TEXT(".c"))
+        || FilePath.EndsWith(TEXT(".cs"))
+        || FilePath.EndsWith(TEXT(".uplugin"));
+}
+
+bool FBuildInputManifest::IsPossibleDirectory(const FString& Path)
+{
+    if (Path.Contains(TEXT("/Intermediate/")) || Path.Contains(TEXT("/Binaries/")))
+    {
+        return false;
+    }
+
+    // A removed directory can no longer be checked on disk, so treat any path without an extension as one
+    return FPaths::GetExtension(Path).IsEmpty() || IFileManager::Get().DirectoryExists(*Path);
+}
+
+FXxHash64 FBuildInputManifest::HashFile(const FString& FilePath)
+{
+    // Map the file rather than copying it into memory
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*FilePath));
+    if (MappedFile.IsValid() && MappedFile->GetFileSize() > 0)
+    {
+        TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+        if (MappedRegion.IsValid())
+        {
+            return FXxHash64::HashBuffer(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize());
+        }
+    }
+
+    // Empty files cannot be mapped, and not every platform file supports mapping
+    TArray<uint8> Contents;
+    FFileHelper::LoadFileToArray(Contents, *FilePath, FILEREAD_Silent);
+    return FXxHash64::HashBuffer(Contents.GetData(), Contents.Num());
+}
+
+TArray<FString> FBuildInputManifest::FindBuildInputs() const
+{
+    TArray<FString> FilePaths;
+    for (const FString& RootDirectory : RootDirectories)
+    {
+        IFileManager::Get().IterateDirectoryRecursively(*RootDirectory, [&FilePaths](const TCHAR* FilenameOrDirectory, bool bIsDirectory)
+        {
+            if (!bIsDirectory && IsBuildInput(FilenameOrDirectory))
+            {
+                FilePaths.Add(FilenameOrDirectory);
+            }
+            return true;
+        });
+    }
+
+    return FilePaths;
+}
+
+void FBuildInputManifest::HashFiles(const TArray<FString>& FilePaths)
+{
+    TArray<FXxHash64> Hashes;
+    TArray<bool> Exists;
+    Hashes.SetNum(FilePaths.Num());
+    Exists.SetNum(FilePaths.Num());
+
+    ParallelFor(FilePaths.Num(), [&FilePaths, &Hashes, &Exists](int32 Index)
+    {
+        Exists[Index] = IFileManager::Get().FileExists(*FilePaths[Index]);
+        if (Exists[Index])
+        {
+            Hashes[Index] = HashFile(FilePaths[Index]);
+        }
+    });
+
+    FScopeLock ScopeLock(&Lock);
+    for (int32 Index = 0; Index < FilePaths.Num(); ++Index)
+    {
+        if (Exists[Index])
+        {
+            FileHashes.Add(FilePaths[Index], Hashes[Index]);
+        }
+        else
+        {
+            FileHashes.Remove(FilePaths[Index]);
+        }
+    }
+}
+
+void FBuildInputManifest::OnDirectoryChanged(const TArray<FFileChangeData>& Changes)
+{
+    FScopeLock ScopeLock(&Lock);
+    for (const FFileChangeData& Change : Changes)
+    {
+        if (Change.Action == FFileChangeData::FCA_RescanRequired)
+        {
+            bRescanRequired = true;
+            continue;
+        }
+
+        FString FilePath = Change.Filename;
+        FPaths::NormalizeFilename(FilePath);
+        if (IsBuildInput(FilePath))
+        {
+            // Removed files are dropped when rehashing finds them missing
+            DirtyFiles.Add(FilePath);
+        }
+        else if (Change.Action != FFileChangeData::FCA_Modified && IsPossibleDirectory(FilePath))
+        {
+            // Renaming, moving or deleting a directory only reports the directory itself, not the files in it
+            bRescanRequired = true;
+        }
+    }
+}
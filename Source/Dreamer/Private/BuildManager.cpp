@@ -11,9 +11,14 @@
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Editor.h"
 #include "ISourceCodeAccessModule.h"
-#include "Developer/HotReload/Public/IHotReload.h"
+#include "HAL/FileManager.h"
+#include "Async/Async.h"
+#if WITH_LIVE_CODING
+#include "ILiveCodingModule.h"
+#endif
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "OutputReaderRunnable.h"
+#include "BuildInputManifest.h"
 
 FBuildManager::FBuildManager()
     : BuildProgress(0.0f)
@@ -29,11 +34,47 @@ FBuildManager::~FBuildManager()
 
 void FBuildManager::Initialize()
 {
-    // Initialize any necessary resources
+    // The sources as they are now are what the running editor was built from
+    CaptureModuleSourceStates();
+
+    // Start hashing the build inputs so unchanged builds can be skipped
+    TArray<FString> RootDirectories;
+    RootDirectories.Add(FPaths::ConvertRelativePathToFull(FPaths::GameSourceDir()));
+    RootDirectories.Add(FPaths::ConvertRelativePathToFull(FPaths::ProjectPluginsDir()));
+
+    TArray<FString> ExtraFiles;
+    ExtraFiles.Add(FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+
+    InputManifest = MakeShared<FBuildInputManifest>();
+    InputManifest->Initialize(RootDirectories, ExtraFiles);
 }
 
 void FBuildManager::Shutdown()
 {
+    if (PatchTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(PatchTickerHandle);
+        PatchTickerHandle.Reset();
+    }
+
+#if WITH_LIVE_CODING
+    if (PatchCompleteHandle.IsValid())
+    {
+        if (ILiveCodingModule* LiveCoding = FModuleManager::GetModulePtr<ILiveCodingModule>(LIVE_CODING_MODULE_NAME))
+        {
+            LiveCoding->GetOnPatchCompleteDelegate().Remove(PatchCompleteHandle);
+        }
+        PatchCompleteHandle.Reset();
+    }
+#endif
+    PendingPatch.Reset();
+
+    if (InputManifest.IsValid())
+    {
+        InputManifest->Shutdown();
+        InputManifest.Reset();
+    }
+
     // Cancel any in-progress build
     if (bBuildInProgress)
     {
@@ -49,6 +90,74 @@ void FBuildManager::BuildProject(const FString& Configuration, const FString& Ta
         return;
     }
 
+    FXxHash64 InputHash;
+    const bool bHasInputHash = ComputeBuildInputHash(Configuration, Target, InputHash);
+    if (bHasInputHash && TryUseCachedBuildResult(InputHash))
+    {
+        return;
+    }
+
+    StartBuild(Configuration, Target);
+
+    if (bBuildInProgress && bHasInputHash)
+    {
+        CurrentBuildInputHash = InputHash;
+    }
+}
+
+bool FBuildManager::ComputeBuildInputHash(const FString& Configuration, const FString& Target, FXxHash64& OutHash) const
+{
+    FXxHash64 ManifestHash;
+    if (!InputManifest.IsValid() || !InputManifest->ComputeHash(ManifestHash))
+    {
+        return false;
+    }
+
+    const FString BuildKey = FString::Printf(TEXT("%s|%s"), *Configuration, *Target);
+
+    FXxHash64Builder Builder;
+    Builder.Update(&ManifestHash.Hash, sizeof(ManifestHash.Hash));
+    Builder.Update(*BuildKey, BuildKey.Len() * sizeof(TCHAR));
+    OutHash = Builder.Finalize();
+    return true;
+}
+
+bool FBuildManager::TryUseCachedBuildResult(const FXxHash64& InputHash)
+{
+    if (!CachedBuildResult.IsSet() || CachedBuildResult->InputHash != InputHash)
+    {
+        return false;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Build inputs unchanged (%d files), reusing the last build result"), InputManifest->GetNumFiles());
+
+    BuildErrors.Empty();
+    BuildWarnings = CachedBuildResult->Warnings;
+    BuildProgress = 1.0f;
+
+    BuildStartedEvent.Broadcast();
+    BuildErrorsChangedEvent.Broadcast();
+    BuildProgressEvent.Broadcast(BuildProgress);
+
+    FNotificationInfo Info(NSLOCTEXT("DreamerBuildManager", "BuildUpToDate", "Build is up to date, no source changes since the last build"));
+    Info.bFireAndForget = true;
+    Info.bUseSuccessFailIcons = true;
+    Info.FadeOutDuration = 1.0f;
+    TSharedPtr<SNotificationItem> NotificationItem = FSlateNotificationManager::Get().AddNotification(Info);
+    NotificationItem->SetCompletionState(SNotificationItem::CS_Success);
+
+    BuildCompletedEvent.Broadcast(true);
+    return true;
+}
+
+void FBuildManager::StartBuild(const FString& Configuration, const FString& Target)
+{
+    if (bBuildInProgress)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("A build is already in progress"));
+        return;
+    }
+
     // Clear previous build messages
     ClearBuildMessages();
 
@@ -56,6 +165,7 @@ void FBuildManager::BuildProject(const FString& Configuration, const FString& Ta
     bBuildInProgress = true;
     bCancellationRequested = false;
     BuildProgress = 0.0f;
+    BuildStartTime = FPlatformTime::Seconds();
 
     // Notify that a build has started
     BuildStartedEvent.Broadcast();
@@ -83,19 +193,21 @@ void FBuildManager::BuildProject(const FString& Configuration, const FString& Ta
 
     // Get engine path
     FString EnginePath = FPaths::ConvertRelativePathToFull(FPaths::EngineDir());
-    FString UATPath = FPaths::Combine(EnginePath, TEXT("Build/BatchFiles"));
+    FString BatchFilesPath = FPaths::Combine(EnginePath, TEXT("Build/BatchFiles"));
+    FString PlatformName = TEXT("Win64"); // Default to Win64, could be parameterized later
+    FString UATPath;
+    FString CommandLine;
 
 #if PLATFORM_WINDOWS
-    UATPath = FPaths::Combine(UATPath, TEXT("RunUAT.bat"));
+    UATPath = FPaths::Combine(BatchFilesPath, TEXT("RunUAT.bat"));
 #else
-    UATPath = FPaths::Combine(UATPath, TEXT("RunUAT.sh"));
+    UATPath = FPaths::Combine(BatchFilesPath, TEXT("RunUAT.sh"));
 #endif
 
     // Build command line
-    FString PlatformName = TEXT("Win64"); // Default to Win64, could be parameterized later
-    FString CommandLine = FString::Printf(TEXT("BuildEditor -Project=\"%s\" -Target=%s%s -Platform=%s -Configuration=%s -WaitMutex -FromMsBuild"),
+    CommandLine = FString::Printf(TEXT("BuildEditor -Project=\"%s\" -Target=%s%s -Platform=%s -Configuration=%s -WaitMutex -FromMsBuild"),
         *ProjectPath,
-        *FApp::GetProjectName(),
+        FApp::GetProjectName(),
         *Target,
         *PlatformName,
         *Configuration);
@@ -141,6 +253,280 @@ void FBuildManager::BuildProject(const FString& Configuration, const FString& Ta
     }
 }
 
+void FBuildManager::FastIterate(const FString& Configuration, const FString& Target)
+{
+    if (bBuildInProgress || PendingPatch.IsSet())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("A build is already in progress"));
+        return;
+    }
+
+    FFastIterationResult Result;
+    Result.ChangedModules = GetChangedModules();
+    Result.FullBuildSeconds = LastFullBuildSeconds;
+
+    if (Result.ChangedModules.Num() == 0)
+    {
+        UE_LOG(LogTemp, Display, TEXT("Fast iteration: no module sources changed since the last build"));
+        ReportFastIteration(Result);
+        return;
+    }
+
+    // Interface changes (headers, Build.cs) may change class layouts, which cannot be patched safely
+    bool bInterfaceChanged = false;
+    for (const FString& ModuleName : Result.ChangedModules)
+    {
+        const FModuleSourceState& PreviousState = ModuleSourceStates.FindChecked(ModuleName);
+        if (ScanModule(PreviousState.Directory).NewestInterface > PreviousState.NewestInterface)
+        {
+            bInterfaceChanged = true;
+            break;
+        }
+    }
+
+    if (!bInterfaceChanged)
+    {
+        // The result is reported once the patch has been compiled and applied
+        PendingPatch.Emplace();
+        PendingPatch->Result = Result;
+        PendingPatch->Configuration = Configuration;
+        PendingPatch->Target = Target;
+
+        if (StartLiveCodingPatch())
+        {
+            return;
+        }
+
+        PendingPatch.Reset();
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Fast iteration: %s, starting a full build"),
+        bInterfaceChanged ? TEXT("interface changed") : TEXT("Live Coding patch not started"));
+
+    FallBackToFullBuild(Result, Configuration, Target);
+}
+
+void FBuildManager::FallBackToFullBuild(const FFastIterationResult& Result, const FString& Configuration, const FString& Target)
+{
+    // The result is reported once the build completes
+    LastFastIterationResult = Result;
+    bPendingFastIteration = true;
+    BuildProject(Configuration, Target);
+
+    // An up to date or failed to start build completes without going through the build process
+    if (!bBuildInProgress && bPendingFastIteration)
+    {
+        bPendingFastIteration = false;
+        ReportFastIteration(Result);
+    }
+}
+
+TArray<FString> FBuildManager::GetChangedModules() const
+{
+    TArray<FString> ChangedModules;
+    for (const TPair<FString, FModuleSourceState>& Pair : ModuleSourceStates)
+    {
+        if (ScanModule(Pair.Value.Directory).NewestSource > Pair.Value.NewestSource)
+        {
+            ChangedModules.Add(Pair.Key);
+        }
+    }
+
+    return ChangedModules;
+}
+
+void FBuildManager::CaptureModuleSourceStates()
+{
+    ModuleSourceStates.Reset();
+
+    // Every directory containing a Build.cs is a module
+    TArray<FString> BuildFiles;
+    IFileManager::Get().FindFilesRecursive(BuildFiles, *FPaths::Combine(FPaths::ProjectDir(), TEXT("Source")), TEXT("*.Build.cs"), true, false);
+    IFileManager::Get().FindFilesRecursive(BuildFiles, *FPaths::ProjectPluginsDir(), TEXT("*.Build.cs"), true, false, false);
+
+    for (const FString& BuildFile : BuildFiles)
+    {
+        FString ModuleName = FPaths::GetCleanFilename(BuildFile);
+        ModuleName.RemoveFromEnd(TEXT(".Build.cs"));
+
+        ModuleSourceStates.Add(ModuleName, ScanModule(FPaths::GetPath(BuildFile)));
+    }
+}
+
+FBuildManager::FModuleSourceState FBuildManager::ScanModule(const FString& Directory)
+{
+    FModuleSourceState State;
+    State.Directory = Directory;
+    State.NewestSource = FDateTime::MinValue();
+    State.NewestInterface = FDateTime::MinValue();
+
+    IFileManager::Get().IterateDirectoryStatRecursively(*Directory, [&State](const TCHAR* FilenameOrDirectory, const FFileStatData& StatData)
+    {
+        if (StatData.bIsDirectory)
+        {
+            return true;
+        }
+
+        const FString Filename(FilenameOrDirectory);
+        const bool bIsInterface = Filename.EndsWith(TEXT(".h")) || Filename.EndsWith(TEXT(".Build.cs"));
+        const bool bIsSource = bIsInterface || Filename.EndsWith(TEXT(".cpp")) || Filename.EndsWith(TEXT(".inl"));
+
+        if (bIsSource && StatData.ModificationTime > State.NewestSource)
+        {
+            State.NewestSource = StatData.ModificationTime;
+        }
+
+        if (bIsInterface && StatData.ModificationTime > State.NewestInterface)
+        {
+            State.NewestInterface = StatData.ModificationTime;
+        }
+
+        return true;
+    });
+
+    return State;
+}
+
+bool FBuildManager::StartLiveCodingPatch()
+{
+#if WITH_LIVE_CODING
+    ILiveCodingModule* LiveCoding = FModuleManager::GetModulePtr<ILiveCodingModule>(LIVE_CODING_MODULE_NAME);
+    if (LiveCoding == nullptr || LiveCoding->IsCompiling())
+    {
+        return false;
+    }
+
+    if (!LiveCoding->IsEnabledForSession())
+    {
+        if (!LiveCoding->CanEnableForSession())
+        {
+            return false;
+        }
+
+        LiveCoding->EnableForSession(true);
+        if (!LiveCoding->IsEnabledForSession())
+        {
+            return false;
+        }
+    }
+
+    // Unsaved editor files would not be part of the patch
+    IMainFrameModule& MainFrameModule = FModuleManager::LoadModuleChecked<IMainFrameModule>("MainFrame");
+    MainFrameModule.GetMainFrameCommandBindings()->GetActionForCommand("SaveAll")->Execute();
+
+    if (!PatchCompleteHandle.IsValid())
+    {
+        TWeakPtr<FBuildManager> WeakThis = AsShared();
+        PatchCompleteHandle = LiveCoding->GetOnPatchCompleteDelegate().AddLambda([WeakThis]()
+        {
+            TSharedPtr<FBuildManager> This = WeakThis.Pin();
+            if (This.IsValid() && This->PendingPatch.IsSet())
+            {
+                This->PendingPatch->bApplied = true;
+            }
+        });
+    }
+
+    // Without flags the compile is only started, completion is polled from the ticker
+    PendingPatch->StartTime = FPlatformTime::Seconds();
+    ELiveCodingCompileResult CompileResult = ELiveCodingCompileResult::Failure;
+    LiveCoding->Compile(ELiveCodingCompileFlags::None, &CompileResult);
+    if (CompileResult != ELiveCodingCompileResult::InProgress)
+    {
+        UE_LOG(LogTemp, Display, TEXT("Fast iteration: Live Coding did not start compiling, result %d"), static_cast<int32>(CompileResult));
+        return false;
+    }
+
+    PatchTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FBuildManager::TickLiveCodingPatch));
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FBuildManager::TickLiveCodingPatch(float DeltaTime)
+{
+#if WITH_LIVE_CODING
+    ILiveCodingModule* LiveCoding = FModuleManager::GetModulePtr<ILiveCodingModule>(LIVE_CODING_MODULE_NAME);
+    if (LiveCoding != nullptr && LiveCoding->IsCompiling())
+    {
+        return true;
+    }
+#endif
+
+    PatchTickerHandle.Reset();
+    FinishLiveCodingPatch(PendingPatch.IsSet() && PendingPatch->bApplied);
+    return false;
+}
+
+void FBuildManager::FinishLiveCodingPatch(bool bApplied)
+{
+    if (!PendingPatch.IsSet())
+    {
+        return;
+    }
+
+    FPendingPatch Patch = MoveTemp(PendingPatch.GetValue());
+    PendingPatch.Reset();
+
+    const double PatchSeconds = FPlatformTime::Seconds() - Patch.StartTime;
+    UE_LOG(LogTemp, Display, TEXT("Fast iteration: Live Coding finished in %.2f s, patch %s"), PatchSeconds, bApplied ? TEXT("applied") : TEXT("not applied"));
+
+    if (bApplied)
+    {
+        FFastIterationResult Result = Patch.Result;
+        Result.bPatched = true;
+        Result.PatchSeconds = PatchSeconds;
+        Result.SavedSeconds = Result.FullBuildSeconds > 0.0 ? FMath::Max(0.0, Result.FullBuildSeconds - PatchSeconds) : 0.0;
+        CaptureModuleSourceStates();
+        ReportFastIteration(Result);
+    }
+    else
+    {
+        FallBackToFullBuild(Patch.Result, Patch.Configuration, Patch.Target);
+    }
+}
+
+void FBuildManager::ReportFastIteration(const FFastIterationResult& Result)
+{
+    LastFastIterationResult = Result;
+
+    FText Message;
+    if (Result.ChangedModules.Num() == 0)
+    {
+        Message = NSLOCTEXT("DreamerBuildManager", "FastIterationNoChanges", "No source changes to apply");
+    }
+    else if (Result.bPatched)
+    {
+        Message = FText::Format(
+            NSLOCTEXT("DreamerBuildManager", "FastIterationPatched", "Patched {0} module(s) in {1}s (saved ~{2}s)"),
+            FText::AsNumber(Result.ChangedModules.Num()),
+            FText::AsNumber(Result.PatchSeconds),
+            FText::AsNumber(Result.SavedSeconds));
+    }
+    else
+    {
+        Message = FText::Format(
+            NSLOCTEXT("DreamerBuildManager", "FastIterationRebuilt", "Rebuilt the project for {0} changed module(s) in {1}s (saved ~{2}s)"),
+            FText::AsNumber(Result.ChangedModules.Num()),
+            FText::AsNumber(Result.PatchSeconds),
+            FText::AsNumber(Result.SavedSeconds));
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Fast iteration: %s (modules: %s, full build baseline %.2f s)"),
+        *Message.ToString(),
+        *FString::Join(Result.ChangedModules, TEXT(", ")),
+        Result.FullBuildSeconds);
+
+    FNotificationInfo Info(Message);
+    Info.bFireAndForget = true;
+    Info.FadeOutDuration = 1.0f;
+    Info.ExpireDuration = 4.0f;
+    FSlateNotificationManager::Get().AddNotification(Info);
+
+    FastIterationEvent.Broadcast(Result);
+}
+
 void FBuildManager::CancelBuild()
 {
     if (!bBuildInProgress)
@@ -159,6 +545,8 @@ void FBuildManager::CancelBuild()
 
     // Update status
     bBuildInProgress = false;
+    bPendingFastIteration = false;
+    CurrentBuildInputHash.Reset();
     BuildProgress = 0.0f;
 
     // Notify that the build has been cancelled
@@ -219,13 +607,14 @@ void FBuildManager::ParseBuildOutput(const FString& Output)
             int32 LineNumber = FCString::Atoi(*Matcher1.GetCaptureGroup(2));
             int32 ColumnNumber = Matcher1.GetCaptureGroup(4).IsEmpty() ? 0 : FCString::Atoi(*Matcher1.GetCaptureGroup(4));
             FString Type = Matcher1.GetCaptureGroup(5);
+            FString Code = Matcher1.GetCaptureGroup(6).TrimStart();
             FString Message = Matcher1.GetCaptureGroup(7);
 
             EBuildMessageSeverity Severity = Type.Equals(TEXT("error"), ESearchCase::IgnoreCase) 
                 ? EBuildMessageSeverity::Error 
                 : EBuildMessageSeverity::Warning;
 
-            TSharedPtr<FBuildError> BuildError = MakeShared<FBuildError>(Message, FilePath, LineNumber, ColumnNumber, Severity);
+            TSharedPtr<FBuildError> BuildError = MakeShared<FBuildError>(Message, FilePath, LineNumber, ColumnNumber, Severity, Code);
 
             if (Severity == EBuildMessageSeverity::Error)
             {
@@ -292,19 +681,58 @@ void FBuildManager::ParseBuildOutput(const FString& Output)
     }
 }
 
-void FBuildManager::HandleUATOutput(FString Output)
+void FBuildManager::OnBuildFinished(bool bSuccess)
 {
-    // Parse the output for errors and warnings
-    ParseBuildOutput(Output);
+    // Output is handled on the reader thread, build state is only touched on the game thread
+    const double FinishTime = FPlatformTime::Seconds();
+    TWeakPtr<FBuildManager> WeakThis = AsShared();
+    AsyncTask(ENamedThreads::GameThread, [WeakThis, bSuccess, FinishTime]()
+    {
+        if (TSharedPtr<FBuildManager> This = WeakThis.Pin())
+        {
+            This->CompleteBuild(bSuccess, FinishTime);
+        }
+    });
+}
 
-    // Check if the build is complete
-    if (Output.Contains(TEXT("BUILD SUCCESSFUL")) || Output.Contains(TEXT("BUILD COMPLETED SUCCESSFULLY")))
+void FBuildManager::CompleteBuild(bool bSuccess, double FinishTime)
+{
+    // A cancelled build has already been completed
+    if (!bBuildInProgress)
     {
-        // Build succeeded
-        bBuildInProgress = false;
-        BuildProgress = 1.0f;
-        BuildProgressEvent.Broadcast(BuildProgress);
+        return;
+    }
+
+    bBuildInProgress = false;
+
+    const double BuildSeconds = FinishTime - BuildStartTime;
+    const bool bReportFastIteration = bPendingFastIteration;
+    bPendingFastIteration = false;
+
+    TOptional<FXxHash64> InputHash = CurrentBuildInputHash;
+    CurrentBuildInputHash.Reset();
+
+    if (bSuccess)
+    {
+        LastFullBuildSeconds = BuildSeconds;
 
+        // Only successful builds are cached, a failure may be caused by something other than the sources
+        if (InputHash.IsSet())
+        {
+            FCachedBuildResult CachedResult;
+            CachedResult.InputHash = InputHash.GetValue();
+            CachedResult.Warnings = BuildWarnings;
+            CachedBuildResult = MoveTemp(CachedResult);
+        }
+
+        CaptureModuleSourceStates();
+    }
+
+    BuildProgress = 1.0f;
+    BuildProgressEvent.Broadcast(BuildProgress);
+
+    if (bSuccess)
+    {
         // Display a success notification
         FNotificationInfo Info(NSLOCTEXT("DreamerBuildManager", "BuildSucceeded", "Build completed successfully"));
         Info.bFireAndForget = true;
@@ -312,17 +740,9 @@ void FBuildManager::HandleUATOutput(FString Output)
         Info.FadeOutDuration = 1.0f;
         TSharedPtr<SNotificationItem> NotificationItem = FSlateNotificationManager::Get().AddNotification(Info);
         NotificationItem->SetCompletionState(SNotificationItem::CS_Success);
-
-        // Notify that the build has completed
-        BuildCompletedEvent.Broadcast(true);
     }
-    else if (Output.Contains(TEXT("BUILD FAILED")) || Output.Contains(TEXT("BUILD CANCELED")))
+    else
     {
-        // Build failed
-        bBuildInProgress = false;
-        BuildProgress = 1.0f;
-        BuildProgressEvent.Broadcast(BuildProgress);
-
         // Display a failure notification
         FNotificationInfo Info(FText::Format(
             NSLOCTEXT("DreamerBuildManager", "BuildFailed", "Build failed with {0} error(s) and {1} warning(s)"),
@@ -334,8 +754,32 @@ void FBuildManager::HandleUATOutput(FString Output)
         Info.FadeOutDuration = 1.0f;
         TSharedPtr<SNotificationItem> NotificationItem = FSlateNotificationManager::Get().AddNotification(Info);
         NotificationItem->SetCompletionState(SNotificationItem::CS_Fail);
+    }
 
-        // Notify that the build has completed
-        BuildCompletedEvent.Broadcast(false);
+    // Notify that the build has completed
+    BuildCompletedEvent.Broadcast(bSuccess);
+
+    if (bReportFastIteration)
+    {
+        FFastIterationResult Result = LastFastIterationResult;
+        Result.PatchSeconds = BuildSeconds;
+        Result.SavedSeconds = 0.0;
+        ReportFastIteration(Result);
+    }
+}
+
+void FBuildManager::HandleUATOutput(FString Output)
+{
+    // Parse the output for errors and warnings
+    ParseBuildOutput(Output);
+
+    // Check if the build is complete
+    if (Output.Contains(TEXT("BUILD SUCCESSFUL")) || Output.Contains(TEXT("BUILD COMPLETED SUCCESSFULLY")) || Output.Contains(TEXT("Result: Succeeded")))
+    {
+        OnBuildFinished(true);
     }
-}
\ No newline at end of file
+    else if (Output.Contains(TEXT("BUILD FAILED")) || Output.Contains(TEXT("BUILD CANCELED")) || Output.Contains(TEXT("Result: Failed")))
+    {
+        OnBuildFinished(false);
+    }
+}
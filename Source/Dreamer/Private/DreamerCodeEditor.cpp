@@ -13,6 +13,8 @@
 #include "Framework/Text/TextLayout.h"
 #include "Framework/Text/IRun.h"
 #include "Framework/Text/SlateTextRun.h"
+#include "Framework/Application/SlateApplication.h"
+#include "DreamerDocumentCache.h"
 
 #define LOCTEXT_NAMESPACE "SDreamerCodeEditor"
 
@@ -167,6 +169,12 @@ private:
 
 void SDreamerCodeEditor::Construct(const FArguments& InArgs)
 {
+    DocumentCache = InArgs._DocumentCache;
+    if (!DocumentCache.IsValid())
+    {
+        DocumentCache = MakeShared<FDreamerDocumentCache>();
+    }
+
     // Create the C++ syntax highlighter
     TSharedPtr<FCppSyntaxHighlighter> SyntaxHighlighter = MakeShared<FCppSyntaxHighlighter>();
 
@@ -506,14 +514,39 @@ void SDreamerCodeEditor::GetFileTreeChildren(TSharedPtr<FCodeFileItem> Item, TAr
     OutChildren = Item->Children;
 }
 
-void SDreamerCodeEditor::LoadSourceFile(const FString& FilePath)
+bool SDreamerCodeEditor::LoadSourceFile(const FString& FilePath)
+{
+    TSharedPtr<const FDreamerDocument> Document = DocumentCache->GetDocument(FilePath);
+    if (!Document.IsValid())
+    {
+        return false;
+    }
+
+    CurrentFilePath = FilePath;
+    CodeEditor->SetText(FText::FromString(Document->Content));
+    return true;
+}
+
+bool SDreamerCodeEditor::OpenFileAtLocation(const FString& FilePath, int32 LineNumber, int32 ColumnNumber, bool bFocus)
 {
-    FString FileContent;
-    if (FFileHelper::LoadFileToString(FileContent, *FilePath))
+    // Only reload (and re-layout) the document when switching files
+    const bool bIsCurrentFile = !CurrentFilePath.IsEmpty()
+        && FDreamerDocumentCache::NormalizePath(CurrentFilePath) == FDreamerDocumentCache::NormalizePath(FilePath);
+
+    if (!bIsCurrentFile && !LoadSourceFile(FilePath))
+    {
+        return false;
+    }
+
+    const FTextLocation Location(FMath::Max(0, LineNumber - 1), FMath::Max(0, ColumnNumber - 1));
+    CodeEditor->GoTo(Location);
+    CodeEditor->ScrollTo(Location);
+    if (bFocus)
     {
-        CurrentFilePath = FilePath;
-        CodeEditor->SetText(FText::FromString(FileContent));
+        FSlateApplication::Get().SetKeyboardFocus(CodeEditor, EFocusCause::SetDirectly);
     }
+
+    return true;
 }
 
 void SDreamerCodeEditor::SaveCurrentFile()
@@ -521,7 +554,10 @@ void SDreamerCodeEditor::SaveCurrentFile()
     if (!CurrentFilePath.IsEmpty())
     {
         FString Content = CodeEditor->GetText().ToString();
-        FFileHelper::SaveStringToFile(Content, *CurrentFilePath);
+        if (FFileHelper::SaveStringToFile(Content, *CurrentFilePath))
+        {
+            DocumentCache->UpdateDocument(CurrentFilePath, Content);
+        }
     }
 }
 
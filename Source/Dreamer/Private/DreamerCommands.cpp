@@ -8,6 +8,7 @@ void FDreamerCommands::RegisterCommands()
 {
 	UI_COMMAND(OpenCppEditor, "C++ Editor", "Open the integrated C++ Editor", EUserInterfaceActionType::Button, FInputChord(EModifierKey::Control | EModifierKey::Shift, EKeys::E));
 	UI_COMMAND(BuildProject, "Build", "Build the current project", EUserInterfaceActionType::Button, FInputChord(EModifierKey::Control | EModifierKey::Shift, EKeys::B));
+	UI_COMMAND(FastIterate, "Fast Iterate", "Apply source changes through Live Coding, falling back to a full build (left to UnrealBuildTool's own incremental build) if a patch is not possible", EUserInterfaceActionType::Button, FInputChord(EModifierKey::Control | EModifierKey::Alt, EKeys::B));
 	UI_COMMAND(CancelBuild, "Cancel Build", "Cancel the current build", EUserInterfaceActionType::Button, FInputChord());
 	UI_COMMAND(ShowBuildErrors, "Build Errors", "Show build errors and warnings", EUserInterfaceActionType::Button, FInputChord(EModifierKey::Control | EModifierKey::Shift, EKeys::L));
 }
@@ -0,0 +1,162 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DreamerDocumentCache.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/Paths.h"
+#include "Async/Async.h"
+
+FDreamerDocumentCache::FDreamerDocumentCache(int32 InMaxDocuments)
+    : MaxDocuments(FMath::Max(1, InMaxDocuments))
+{
+}
+
+FString FDreamerDocumentCache::NormalizePath(const FString& FilePath)
+{
+    FString NormalizedPath = FPaths::ConvertRelativePathToFull(FilePath);
+    FPaths::NormalizeFilename(NormalizedPath);
+    return NormalizedPath;
+}
+
+TSharedPtr<const FDreamerDocument> FDreamerDocumentCache::GetDocument(const FString& InFilePath)
+{
+    const FString FilePath = NormalizePath(InFilePath);
+    const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*FilePath);
+
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (TSharedPtr<const FDreamerDocument> Document = FindCurrent(FilePath, Timestamp))
+        {
+            return Document;
+        }
+    }
+
+    // Read outside the lock so prefetches of other files are not blocked
+    TSharedPtr<const FDreamerDocument> Document = ReadDocument(FilePath);
+    if (Document.IsValid())
+    {
+        FScopeLock ScopeLock(&Lock);
+        AddDocument(FilePath, Document);
+    }
+
+    return Document;
+}
+
+void FDreamerDocumentCache::Prefetch(const TArray<FString>& FilePaths)
+{
+    TArray<FString> FilesToLoad;
+    {
+        FScopeLock ScopeLock(&Lock);
+        for (const FString& InFilePath : FilePaths)
+        {
+            const FString FilePath = NormalizePath(InFilePath);
+            if (!Entries.Contains(FilePath))
+            {
+                FilesToLoad.AddUnique(FilePath);
+            }
+        }
+    }
+
+    if (FilesToLoad.Num() == 0)
+    {
+        return;
+    }
+
+    TWeakPtr<FDreamerDocumentCache> WeakThis = AsShared();
+    Async(EAsyncExecution::ThreadPool, [WeakThis, FilesToLoad = MoveTemp(FilesToLoad)]()
+    {
+        for (const FString& FilePath : FilesToLoad)
+        {
+            TSharedPtr<const FDreamerDocument> Document = ReadDocument(FilePath);
+            TSharedPtr<FDreamerDocumentCache> This = WeakThis.Pin();
+            if (!This.IsValid())
+            {
+                return;
+            }
+
+            if (Document.IsValid())
+            {
+                FScopeLock ScopeLock(&This->Lock);
+
+                // Do not replace a document that was loaded or saved in the meantime
+                if (!This->Entries.Contains(FilePath))
+                {
+                    This->AddDocument(FilePath, Document);
+                }
+            }
+        }
+    });
+}
+
+void FDreamerDocumentCache::UpdateDocument(const FString& InFilePath, const FString& Content)
+{
+    const FString FilePath = NormalizePath(InFilePath);
+    TSharedPtr<FDreamerDocument> Document = MakeShared<FDreamerDocument>();
+    Document->Content = Content;
+    Document->Timestamp = IFileManager::Get().GetTimeStamp(*FilePath);
+
+    FScopeLock ScopeLock(&Lock);
+    AddDocument(FilePath, Document);
+}
+
+void FDreamerDocumentCache::Invalidate(const FString& FilePath)
+{
+    FScopeLock ScopeLock(&Lock);
+    Entries.Remove(NormalizePath(FilePath));
+}
+
+TSharedPtr<const FDreamerDocument> FDreamerDocumentCache::FindCurrent(const FString& FilePath, const FDateTime& Timestamp)
+{
+    FEntry* Entry = Entries.Find(FilePath);
+    if (Entry == nullptr)
+    {
+        return nullptr;
+    }
+
+    // The file has changed on disk since it was cached
+    if (Entry->Document->Timestamp != Timestamp)
+    {
+        Entries.Remove(FilePath);
+        return nullptr;
+    }
+
+    Entry->LastAccess = ++AccessCounter;
+    return Entry->Document;
+}
+
+TSharedPtr<const FDreamerDocument> FDreamerDocumentCache::ReadDocument(const FString& FilePath)
+{
+    TSharedPtr<FDreamerDocument> Document = MakeShared<FDreamerDocument>();
+    Document->Timestamp = IFileManager::Get().GetTimeStamp(*FilePath);
+
+    if (!FFileHelper::LoadFileToString(Document->Content, *FilePath))
+    {
+        return nullptr;
+    }
+
+    return Document;
+}
+
+void FDreamerDocumentCache::AddDocument(const FString& FilePath, const TSharedPtr<const FDreamerDocument>& Document)
+{
+    FEntry& Entry = Entries.FindOrAdd(FilePath);
+    Entry.Document = Document;
+    Entry.LastAccess = ++AccessCounter;
+
+    while (Entries.Num() > MaxDocuments)
+    {
+        const FString* OldestPath = nullptr;
+        uint64 OldestAccess = MAX_uint64;
+        for (const TPair<FString, FEntry>& Pair : Entries)
+        {
+            if (Pair.Value.LastAccess < OldestAccess)
+            {
+                OldestAccess = Pair.Value.LastAccess;
+                OldestPath = &Pair.Key;
+            }
+        }
+
+        Entries.Remove(FString(*OldestPath));
+    }
+}
@@ -9,10 +9,12 @@
 #include "Widgets/Text/STextBlock.h"
 #include "ToolMenus.h"
 #include "DreamerCodeEditor.h"
+#include "DreamerDocumentCache.h"
 #include "BuildManager.h"
 #include "BuildErrorList.h"
 #include "ISourceCodeAccessModule.h"
 #include "ISourceCodeAccessor.h"
+#include "HAL/IConsoleManager.h"
 
 static const FName DreamerTabName("Dreamer");
 static const FName BuildErrorsTabName("DreamerBuildErrors");
@@ -30,6 +32,9 @@ void FDreamerModule::StartupModule()
 	
 	PluginCommands = MakeShareable(new FUICommandList);
 
+	// Create the document cache shared by the code editor and error navigation
+	DocumentCache = MakeShared<FDreamerDocumentCache>();
+
 	// Create the build manager
 	BuildManager = MakeShareable(new FBuildManager());
 	BuildManager->Initialize();
@@ -52,6 +57,18 @@ void FDreamerModule::StartupModule()
 			return BuildManager.IsValid() && !BuildManager->IsBuildInProgress();
 		}));
 
+	PluginCommands->MapAction(
+		FDreamerCommands::Get().FastIterate,
+		FExecuteAction::CreateLambda([this]() {
+			if (BuildManager.IsValid())
+			{
+				BuildManager->FastIterate();
+			}
+		}),
+		FCanExecuteAction::CreateLambda([this]() {
+			return BuildManager.IsValid() && !BuildManager->IsBuildInProgress();
+		}));
+
 	PluginCommands->MapAction(
 		FDreamerCommands::Get().CancelBuild,
 		FExecuteAction::CreateLambda([this]() {
@@ -83,6 +100,13 @@ void FDreamerModule::StartupModule()
 		.SetDisplayName(LOCTEXT("FBuildErrorsTabTitle", "Build Errors"))
 		.SetMenuType(ETabSpawnerMenuType::Hidden);
 
+	// Register console commands
+	ScrollBenchmarkCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("Dreamer.ErrorList.ScrollBenchmark"),
+		TEXT("Fills the build error list with synthetic messages and scrolls through them, logging frame times. Usage: Dreamer.ErrorList.ScrollBenchmark [NumMessages]"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FDreamerModule::RunErrorListScrollBenchmark),
+		ECVF_Default);
+
 	// Register for build manager events
 	if (BuildManager.IsValid())
 	{
@@ -98,6 +122,13 @@ void FDreamerModule::StartupModule()
 
 void FDreamerModule::ShutdownModule()
 {
+	// Unregister console commands
+	if (ScrollBenchmarkCommand)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(ScrollBenchmarkCommand);
+		ScrollBenchmarkCommand = nullptr;
+	}
+
 	// Unregister tab spawners
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(BuildErrorsTabName);
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(DreamerTabName);
@@ -109,6 +140,8 @@ void FDreamerModule::ShutdownModule()
 	// Unregister commands
 	FDreamerCommands::Unregister();
 
+	DocumentCache.Reset();
+
 	// Shutdown build manager
 	if (BuildManager.IsValid())
 	{
@@ -122,6 +155,10 @@ void FDreamerModule::ShutdownModule()
 
 TSharedRef<SDockTab> FDreamerModule::OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs)
 {
+	TSharedRef<SDreamerCodeEditor> CodeEditorWidget = SNew(SDreamerCodeEditor)
+		.DocumentCache(DocumentCache);
+	CodeEditor = CodeEditorWidget;
+
 	return SNew(SDockTab)
 		.TabRole(ETabRole::NomadTab)
 		[
@@ -283,7 +320,7 @@ TSharedRef<SDockTab> FDreamerModule::OnSpawnPluginTab(const FSpawnTabArgs& Spawn
 			+ SVerticalBox::Slot()
 			.FillHeight(1.0f)
 			[
-				SNew(SDreamerCodeEditor)
+				CodeEditorWidget
 			]
 		];
 }
@@ -310,18 +347,55 @@ TSharedRef<SDockTab> FDreamerModule::OnSpawnBuildErrorsTab(const FSpawnTabArgs&
 		];
 }
 
+void FDreamerModule::RunErrorListScrollBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumMessages = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+
+	FGlobalTabmanager::Get()->TryInvokeTab(BuildErrorsTabName);
+	if (BuildErrorList.IsValid())
+	{
+		BuildErrorList->RunScrollBenchmark(NumMessages);
+	}
+}
+
 void FDreamerModule::OpenCppEditorTab()
 {
 	FGlobalTabmanager::Get()->TryInvokeTab(DreamerTabName);
 }
 
-void FDreamerModule::OpenFileAtLocation(const FString& FilePath, int32 LineNumber)
+void FDreamerModule::OpenFileAtLocation(const FString& FilePath, int32 LineNumber, int32 ColumnNumber, bool bActivate)
 {
-	// Use the source code access module to open the file
+	// Prefer the built-in editor, which can reuse its cached documents
+	if (bActivate)
+	{
+		FGlobalTabmanager::Get()->TryInvokeTab(DreamerTabName);
+	}
+
+	TSharedPtr<SDreamerCodeEditor> CodeEditorWidget = CodeEditor.Pin();
+	if (CodeEditorWidget.IsValid() && CodeEditorWidget->OpenFileAtLocation(FilePath, LineNumber, ColumnNumber, bActivate))
+	{
+		return;
+	}
+
+	// Passive updates never pull up an external editor
+	if (!bActivate)
+	{
+		return;
+	}
+
+	// Otherwise use the source code access module to open the file
 	ISourceCodeAccessModule& SourceCodeAccessModule = FModuleManager::LoadModuleChecked<ISourceCodeAccessModule>("SourceCodeAccess");
 	if (SourceCodeAccessModule.GetAccessor().IsAvailable())
 	{
-		SourceCodeAccessModule.GetAccessor()->OpenFileAtLine(FilePath, LineNumber);
+		SourceCodeAccessModule.GetAccessor()->OpenFileAtLine(FilePath, LineNumber, ColumnNumber);
+	}
+}
+
+void FDreamerModule::PrefetchFiles(const TArray<FString>& FilePaths)
+{
+	if (DocumentCache.IsValid())
+	{
+		DocumentCache->Prefetch(FilePaths);
 	}
 }
 
@@ -349,6 +423,9 @@ void FDreamerModule::RegisterMenus()
 		FToolMenuEntry& BuildEntry = Section.AddEntry(FToolMenuEntry::InitToolBarButton(FDreamerCommands::Get().BuildProject));
 		BuildEntry.SetCommandList(PluginCommands);
 		
+		FToolMenuEntry& FastIterateEntry = Section.AddEntry(FToolMenuEntry::InitToolBarButton(FDreamerCommands::Get().FastIterate));
+		FastIterateEntry.SetCommandList(PluginCommands);
+		
 		FToolMenuEntry& CancelBuildEntry = Section.AddEntry(FToolMenuEntry::InitToolBarButton(FDreamerCommands::Get().CancelBuild));
 		CancelBuildEntry.SetCommandList(PluginCommands);
 		
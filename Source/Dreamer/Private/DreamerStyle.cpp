@@ -48,6 +48,8 @@ TSharedRef<FSlateStyleSet> FDreamerStyle::CreateStyleSet()
 	// Icons for build actions
 	Style->Set("Dreamer.BuildProject", new IMAGE_BRUSH(TEXT("BuildIcon_40x"), FVector2D(40.0f, 40.0f)));
 	Style->Set("Dreamer.BuildProject.Small", new IMAGE_BRUSH(TEXT("BuildIcon_40x"), FVector2D(20.0f, 20.0f)));
+	Style->Set("Dreamer.FastIterate", new IMAGE_BRUSH(TEXT("BuildIcon_40x"), FVector2D(40.0f, 40.0f)));
+	Style->Set("Dreamer.FastIterate.Small", new IMAGE_BRUSH(TEXT("BuildIcon_40x"), FVector2D(20.0f, 20.0f)));
 	
 	Style->Set("Dreamer.CancelBuild", new IMAGE_BRUSH(TEXT("CancelBuildIcon_40x"), FVector2D(40.0f, 40.0f)));
 	Style->Set("Dreamer.CancelBuild.Small", new IMAGE_BRUSH(TEXT("CancelBuildIcon_40x"), FVector2D(20.0f, 20.0f)));
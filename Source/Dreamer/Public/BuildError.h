@@ -17,9 +17,10 @@ class FBuildError
 {
 public:
     /** Constructor */
-    FBuildError(const FString& InMessage, const FString& InFilePath, int32 InLineNumber, int32 InColumnNumber, EBuildMessageSeverity InSeverity)
+    FBuildError(const FString& InMessage, const FString& InFilePath, int32 InLineNumber, int32 InColumnNumber, EBuildMessageSeverity InSeverity, const FString& InCode = FString())
         : Message(InMessage)
         , FilePath(InFilePath)
+        , Code(InCode)
         , LineNumber(InLineNumber)
         , ColumnNumber(InColumnNumber)
         , Severity(InSeverity)
@@ -32,6 +33,9 @@ public:
     /** Gets the file path */
     const FString& GetFilePath() const { return FilePath; }
 
+    /** Gets the compiler diagnostic code (e.g. C2065), empty if none was reported */
+    const FString& GetCode() const { return Code; }
+
     /** Gets the line number */
     int32 GetLineNumber() const { return LineNumber; }
 
@@ -48,6 +52,9 @@ private:
     /** The file path */
     FString FilePath;
 
+    /** The compiler diagnostic code */
+    FString Code;
+
     /** The line number */
     int32 LineNumber;
 
@@ -6,8 +6,45 @@
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Views/SListView.h"
+#include "Widgets/Views/SHeaderRow.h"
 #include "BuildError.h"
 
+/** Filter and sort settings applied to the build message list */
+struct FBuildErrorListQuery
+{
+    /** Which severities are shown */
+    bool bShowErrors = true;
+    bool bShowWarnings = true;
+    bool bShowInfos = true;
+
+    /** Substring filters, empty means no filtering (case insensitive) */
+    FString TextFilter;
+    FString FileFilter;
+    FString CodeFilter;
+
+    /** Primary sort column and direction */
+    FName PrimarySortColumn;
+    EColumnSortMode::Type PrimarySortMode = EColumnSortMode::None;
+
+    /** Secondary sort column and direction */
+    FName SecondarySortColumn;
+    EColumnSortMode::Type SecondarySortMode = EColumnSortMode::None;
+};
+
+/** Display data for one build message, formatted once and shared by every row that shows it */
+struct FBuildErrorRowCache
+{
+    /** File name without its directory */
+    FString FileName;
+
+    /** Line (and column, if known) as text */
+    FString LineText;
+
+    /** Severity icon and text color */
+    const FSlateBrush* Icon = nullptr;
+    FLinearColor TextColor = FLinearColor::White;
+};
+
 /**
  * Widget that displays a list of build errors and warnings
  */
@@ -30,22 +67,117 @@ public:
     /** Clears all errors and warnings */
     void ClearAll();
 
+    /**
+     * Replaces the contents with synthetic messages and scrolls through them one page per frame,
+     * logging frame times and the number of generated rows when done.
+     */
+    void RunScrollBenchmark(int32 NumMessages);
+
 private:
+    /** Advances the scroll benchmark by one page */
+    EActiveTimerReturnType TickScrollBenchmark(double InCurrentTime, float InDeltaTime);
+
+    /** Replaces all messages of the given severity and refreshes the visible list */
+    void ReplaceMessages(EBuildMessageSeverity Severity, const TArray<TSharedPtr<FBuildError>>& InMessages);
+
+    /**
+     * Kicks off a background filter and sort of the current messages. The result replaces the visible
+     * list on the game thread, unless a newer request has been issued in the meantime.
+     */
+    void RequestFilterRefresh();
+
+    /** Builds the permutation of message indices that pass the query, in sorted order. Safe to run on any thread. */
+    static TArray<int32> BuildVisibleIndices(const TArray<TSharedPtr<FBuildError>>& Messages, const FBuildErrorListQuery& InQuery);
+
+    /** Called on the game thread when a background filter pass has finished */
+    void OnFilterRefreshCompleted(int32 Generation, TArray<TSharedPtr<FBuildError>>&& InVisibleMessages);
+
+    /** Handles the clear all button */
+    FReply OnClearAllClicked();
+
+    /** Gets the text for the message count label */
+    FText GetMessageCountText() const;
+
+    /** Severity filter toggles */
+    ECheckBoxState IsSeverityShown(EBuildMessageSeverity Severity) const;
+    void OnSeverityFilterChanged(ECheckBoxState NewState, EBuildMessageSeverity Severity);
+
+    /** Text filter handlers */
+    void OnTextFilterChanged(const FText& InText);
+    void OnFileFilterChanged(const FText& InText);
+    void OnCodeFilterChanged(const FText& InText);
+
+    /** Column sorting */
+    EColumnSortMode::Type GetColumnSortMode(const FName ColumnId) const;
+    EColumnSortPriority::Type GetColumnSortPriority(const FName ColumnId) const;
+    void OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type InSortMode);
+
+    /** Number of messages following the selection whose files are prefetched */
+    static constexpr int32 NumPrefetchedMessages = 8;
+
     /** Called when an error is selected */
     void OnErrorSelected(TSharedPtr<FBuildError> InError, ESelectInfo::Type SelectType);
 
     /** Creates a row for the error list */
     TSharedRef<ITableRow> OnGenerateRow(TSharedPtr<FBuildError> InError, const TSharedRef<STableViewBase>& OwnerTable);
 
+    /** Gets or creates the display cache for a message */
+    TSharedRef<const FBuildErrorRowCache> GetRowCache(const TSharedPtr<FBuildError>& InError);
+
     /** Gets the text color for an error */
     FSlateColor GetErrorTextColor(TSharedPtr<FBuildError> InError) const;
 
     /** Gets the severity icon for an error */
     const FSlateBrush* GetSeverityIcon(TSharedPtr<FBuildError> InError) const;
 
-    /** The list of all errors and warnings */
-    TArray<TSharedPtr<FBuildError>> AllMessages;
+    /**
+     * The list of all errors and warnings. Never modified in place, so background filter passes can keep
+     * reading a snapshot while the list is replaced.
+     */
+    TSharedRef<const TArray<TSharedPtr<FBuildError>>> AllMessages = MakeShared<const TArray<TSharedPtr<FBuildError>>>();
+
+    /** The filtered and sorted messages shown by the list view */
+    TArray<TSharedPtr<FBuildError>> VisibleMessages;
+
+    /** Current filter and sort settings */
+    FBuildErrorListQuery Query;
+
+    /** Incremented with every filter request, used to discard stale results */
+    int32 FilterGeneration = 0;
+
+    /** Generation of the last filter result applied to the view */
+    int32 CompletedFilterGeneration = 0;
+
+    /** Display caches of messages that have been shown, reset whenever the messages change */
+    TMap<const FBuildError*, TSharedRef<const FBuildErrorRowCache>> RowCaches;
+
+    /** Font shared by all rows, and its line height */
+    FSlateFontInfo RowFont;
+    float RowTextHeight = 0.0f;
+
+    /** Number of rows generated since construction */
+    int32 GeneratedRowCount = 0;
+
+    /** State of a running scroll benchmark */
+    struct FScrollBenchmark
+    {
+        double LastFrameTime = 0.0;
+        double TotalFrameTime = 0.0;
+        double MaxFrameTime = 0.0;
+        int32 NumFrames = 0;
+        int32 StartRowCount = 0;
+        float ScrollOffset = 0.0f;
+        bool bStarted = false;
+    };
+    TOptional<FScrollBenchmark> ScrollBenchmark;
+
+    /** Message counts over all messages, updated when messages change */
+    int32 ErrorCount = 0;
+    int32 WarningCount = 0;
 
     /** The error list widget */
     TSharedPtr<SListView<TSharedPtr<FBuildError>>> ErrorListView;
-};
\ No newline at end of file
+
+    /** Header of the error list, whose column widths rows follow */
+    TSharedPtr<SHeaderRow> HeaderRow;
+};
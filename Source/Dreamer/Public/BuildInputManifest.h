@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Hash/xxhash.h"
+#include "Async/Future.h"
+
+struct FFileChangeData;
+
+/**
+ * Content hashes of all build inputs (module sources, headers, Build.cs and Target.cs files) under a set of
+ * root directories. The initial pass hashes every file in parallel on the thread pool, after which a directory
+ * watcher marks changed files so only those are rehashed when the combined hash is requested.
+ */
+class DREAMER_API FBuildInputManifest : public TSharedFromThis<FBuildInputManifest>
+{
+public:
+    /** Destructor */
+    ~FBuildInputManifest();
+
+    /**
+     * Starts watching the given directories and hashes their contents in the background.
+     * Extra files are hashed on every request rather than watched (e.g. the project file).
+     */
+    void Initialize(const TArray<FString>& InRootDirectories, const TArray<FString>& InExtraFiles);
+
+    /** Stops watching for changes */
+    void Shutdown();
+
+    /** Returns true once the initial hash pass has completed */
+    bool IsReady() const;
+
+    /**
+     * Rehashes any files that changed since the last call and returns the combined hash of all inputs.
+     * Returns false if the initial pass has not completed yet. Must be called on the game thread.
+     */
+    bool ComputeHash(FXxHash64& OutHash);
+
+    /** Returns the number of tracked files */
+    int32 GetNumFiles() const;
+
+private:
+    /** Returns true if a file is a build input */
+    static bool IsBuildInput(const FString& FilePath);
+
+    /** Returns true if a changed path may be a directory, whose contents then have to be rescanned */
+    static bool IsPossibleDirectory(const FString& Path);
+
+    /** Hashes a single file, memory mapping it where the platform supports it */
+    static FXxHash64 HashFile(const FString& FilePath);
+
+    /** Finds all build inputs under the root directories */
+    TArray<FString> FindBuildInputs() const;
+
+    /** Hashes the given files in parallel and stores the results */
+    void HashFiles(const TArray<FString>& FilePaths);
+
+    /** Directory watcher callback */
+    void OnDirectoryChanged(const TArray<FFileChangeData>& Changes);
+
+    /** Directories whose build inputs are tracked */
+    TArray<FString> RootDirectories;
+
+    /** Individual files that are always rehashed */
+    TArray<FString> ExtraFiles;
+
+    /** Hash per tracked file */
+    TMap<FString, FXxHash64> FileHashes;
+
+    /** Files changed since they were last hashed */
+    TSet<FString> DirtyFiles;
+
+    /** True if the watcher asked for a full rescan */
+    bool bRescanRequired = false;
+
+    /** Directory watcher registrations, one per root directory */
+    TArray<TPair<FString, FDelegateHandle>> WatcherHandles;
+
+    /** The initial hash pass */
+    TFuture<void> InitialPass;
+
+    /** Guards FileHashes, DirtyFiles and bRescanRequired */
+    mutable FCriticalSection Lock;
+};
@@ -4,9 +4,31 @@
 
 #include "CoreMinimal.h"
 #include "Styling/SlateStyle.h"
+#include "Containers/Ticker.h"
+#include "Hash/xxhash.h"
 #include "BuildError.h"
 
 class FOutputReaderRunnable;
+class FBuildInputManifest;
+
+/** Outcome of a fast iteration request */
+struct FFastIterationResult
+{
+    /** Modules whose sources changed since the last successful build or patch */
+    TArray<FString> ChangedModules;
+
+    /** True if the changes were applied as a Live Coding patch, false if a full build was started instead */
+    bool bPatched = false;
+
+    /** Time taken to compile and apply the patch, or by the full build it fell back to, in seconds */
+    double PatchSeconds = 0.0;
+
+    /** Duration of the last full build, used as the baseline for the saving (0 if none has been measured) */
+    double FullBuildSeconds = 0.0;
+
+    /** Estimated time saved compared to a full build, in seconds */
+    double SavedSeconds = 0.0;
+};
 
 class FBuildManager : public TSharedFromThis<FBuildManager>
 {
@@ -23,9 +45,26 @@ public:
     /** Shuts down the build manager */
     void Shutdown();
 
-    /** Builds the current project */
+    /**
+     * Builds the current project. If no build input has changed since the last successful build of the same
+     * configuration and target, the cached result and diagnostics are returned immediately instead.
+     */
     void BuildProject(const FString& Configuration = TEXT("Development"), const FString& Target = TEXT("Editor"));
 
+    /**
+     * Applies source changes as quickly as possible: changed modules are patched into the running editor
+     * through Live Coding when possible. The patch is compiled without blocking the editor and the result is
+     * reported when it has been applied. Header and Build.cs changes, or a patch that could not be applied,
+     * fall back to a full build.
+     */
+    void FastIterate(const FString& Configuration = TEXT("Development"), const FString& Target = TEXT("Editor"));
+
+    /** Returns the names of modules whose sources changed since the last successful build or patch */
+    TArray<FString> GetChangedModules() const;
+
+    /** Returns the result of the last fast iteration */
+    const FFastIterationResult& GetLastFastIterationResult() const { return LastFastIterationResult; }
+
     /** Cancels the current build */
     void CancelBuild();
 
@@ -59,11 +98,74 @@ public:
     DECLARE_EVENT_OneParam(FBuildManager, FBuildProgressEvent, float /* Progress */);
     FBuildProgressEvent& OnBuildProgressChanged() { return BuildProgressEvent; }
 
+    /** Delegate called when a fast iteration has been handled */
+    DECLARE_EVENT_OneParam(FBuildManager, FFastIterationEvent, const FFastIterationResult& /* Result */);
+    FFastIterationEvent& OnFastIterationCompleted() { return FastIterationEvent; }
+
     /** Delegate called when build errors change */
     DECLARE_EVENT(FBuildManager, FBuildErrorsChangedEvent);
     FBuildErrorsChangedEvent& OnBuildErrorsChanged() { return BuildErrorsChangedEvent; }
 
 private:
+    /** Source state of a single module, captured after each successful build or patch */
+    struct FModuleSourceState
+    {
+        /** Directory containing the module's Build.cs */
+        FString Directory;
+
+        /** Newest modification time of the module's sources and headers */
+        FDateTime NewestSource;
+
+        /** Newest modification time of the module's headers and Build.cs */
+        FDateTime NewestInterface;
+    };
+
+    /** Result of a successful build, reused while its inputs are unchanged */
+    struct FCachedBuildResult
+    {
+        /** Hash of all build inputs, the configuration and the target */
+        FXxHash64 InputHash;
+
+        /** Warnings reported by the build */
+        TArray<TSharedPtr<FBuildError>> Warnings;
+    };
+
+    /** Returns the hash of the current build inputs for a configuration and target, false if not available yet */
+    bool ComputeBuildInputHash(const FString& Configuration, const FString& Target, FXxHash64& OutHash) const;
+
+    /** Completes a build request from the cached result, returns false if there is no matching result */
+    bool TryUseCachedBuildResult(const FXxHash64& InputHash);
+
+    /** Starts a build of the given target */
+    void StartBuild(const FString& Configuration, const FString& Target);
+
+    /** Finds all modules of the project and its plugins and records their current source state */
+    void CaptureModuleSourceStates();
+
+    /** Scans a module directory for the newest source and interface timestamps */
+    static FModuleSourceState ScanModule(const FString& Directory);
+
+    /** Starts compiling the changed modules through Live Coding, returns false if a patch cannot be started */
+    bool StartLiveCodingPatch();
+
+    /** Polls the pending Live Coding patch on the game thread, finishing it once compilation is over */
+    bool TickLiveCodingPatch(float DeltaTime);
+
+    /** Reports the pending patch if it was applied, otherwise falls back to a full build */
+    void FinishLiveCodingPatch(bool bApplied);
+
+    /** Starts a full build for a fast iteration whose changes could not be patched */
+    void FallBackToFullBuild(const FFastIterationResult& Result, const FString& Configuration, const FString& Target);
+
+    /** Called on the output reader thread when the build process reports completion */
+    void OnBuildFinished(bool bSuccess);
+
+    /** Completes the current build on the game thread: bookkeeping, notification and completion events */
+    void CompleteBuild(bool bSuccess, double FinishTime);
+
+    /** Reports a fast iteration result to the user and listeners */
+    void ReportFastIteration(const FFastIterationResult& Result);
+
     /** Parses build output for errors and warnings */
     void ParseBuildOutput(const FString& Output);
 
@@ -79,6 +181,50 @@ private:
     /** Event fired when build errors change */
     FBuildErrorsChangedEvent BuildErrorsChangedEvent;
 
+    /** Event fired when a fast iteration has been handled */
+    FFastIterationEvent FastIterationEvent;
+
+    /** Source state per module name, as of the last successful build or patch */
+    TMap<FString, FModuleSourceState> ModuleSourceStates;
+
+    /** Result of the last fast iteration */
+    FFastIterationResult LastFastIterationResult;
+
+    /** Time the current build was started */
+    double BuildStartTime = 0.0;
+
+    /** True if the current build was started by a fast iteration that is reported on completion */
+    bool bPendingFastIteration = false;
+
+    /** A fast iteration waiting for its Live Coding patch to compile */
+    struct FPendingPatch
+    {
+        FFastIterationResult Result;
+        FString Configuration;
+        FString Target;
+        double StartTime = 0.0;
+
+        /** Set when Live Coding reports that the patch has been applied */
+        bool bApplied = false;
+    };
+    TOptional<FPendingPatch> PendingPatch;
+
+    /** Ticker polling the pending patch, and the Live Coding patch completion binding */
+    FTSTicker::FDelegateHandle PatchTickerHandle;
+    FDelegateHandle PatchCompleteHandle;
+
+    /** Content hashes of all build inputs */
+    TSharedPtr<FBuildInputManifest> InputManifest;
+
+    /** Result of the last successful full build */
+    TOptional<FCachedBuildResult> CachedBuildResult;
+
+    /** Input hash of the current build, if it could be computed when the build started */
+    TOptional<FXxHash64> CurrentBuildInputHash;
+
+    /** Duration of the last successful full build, in seconds */
+    double LastFullBuildSeconds = 0.0;
+
     /** Current build errors */
     TArray<TSharedPtr<FBuildError>> BuildErrors;
 
@@ -9,6 +9,8 @@
 #include "Widgets/Input/SSearchBox.h"
 #include "BuildError.h"
 
+class FDreamerDocumentCache;
+
 struct FCodeFileItem
 {
     FString FileName;
@@ -29,6 +31,8 @@ class DREAMER_API SDreamerCodeEditor : public SCompoundWidget
 public:
     SLATE_BEGIN_ARGS(SDreamerCodeEditor)
     {}
+        /** Cache used to load source files, a private one is created if not set */
+        SLATE_ARGUMENT(TSharedPtr<FDreamerDocumentCache>, DocumentCache)
     SLATE_END_ARGS()
 
     /** Widget constructor */
@@ -37,7 +41,18 @@ public:
     /** Sets the errors for the current file */
     void SetErrors(const TArray<TSharedPtr<FBuildError>>& InErrors);
 
+    /**
+     * Opens a file and moves the cursor to the given location (1-based, a column of 0 means the start of the line).
+     * If the file is already open, only the cursor is moved and the document is not reloaded.
+     * Keyboard focus is moved to the editor only if bFocus is set.
+     * Returns false if the file could not be loaded.
+     */
+    bool OpenFileAtLocation(const FString& FilePath, int32 LineNumber, int32 ColumnNumber, bool bFocus = true);
+
 private:
+    /** Source file contents, shared with prefetching */
+    TSharedPtr<FDreamerDocumentCache> DocumentCache;
+
     /** Text editor widget */
     TSharedPtr<SMultiLineEditableText> CodeEditor;
     
@@ -68,8 +83,8 @@ private:
     /** Gets children for the file tree */
     void GetFileTreeChildren(TSharedPtr<FCodeFileItem> Item, TArray<TSharedPtr<FCodeFileItem>>& OutChildren);
     
-    /** Loads a source file */
-    void LoadSourceFile(const FString& FilePath);
+    /** Loads a source file, returns false if it could not be read */
+    bool LoadSourceFile(const FString& FilePath);
     
     /** Saves the current file */
     void SaveCurrentFile();
@@ -20,6 +20,7 @@ public:
 public:
 	TSharedPtr<FUICommandInfo> OpenCppEditor;
 	TSharedPtr<FUICommandInfo> BuildProject;
+	TSharedPtr<FUICommandInfo> FastIterate;
 	TSharedPtr<FUICommandInfo> CancelBuild;
 	TSharedPtr<FUICommandInfo> ShowBuildErrors;
 };
\ No newline at end of file
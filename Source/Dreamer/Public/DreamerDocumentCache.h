@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/** A source file held in memory by the document cache */
+struct FDreamerDocument
+{
+    /** The full file contents */
+    FString Content;
+
+    /** File modification time when the contents were read */
+    FDateTime Timestamp;
+};
+
+/**
+ * Thread-safe cache of source file contents used by the code editor, so that switching between files
+ * (e.g. when stepping through build errors) does not have to wait for disk I/O. Files can be prefetched
+ * on a background thread ahead of being opened.
+ */
+class DREAMER_API FDreamerDocumentCache : public TSharedFromThis<FDreamerDocumentCache>
+{
+public:
+    /** Constructor */
+    explicit FDreamerDocumentCache(int32 InMaxDocuments = 64);
+
+    /**
+     * Returns the contents of a file, loading it synchronously if it is not cached or has changed on disk.
+     * Returns nullptr if the file cannot be read.
+     */
+    TSharedPtr<const FDreamerDocument> GetDocument(const FString& FilePath);
+
+    /** Loads the given files on a background thread, skipping those that are already cached and up to date */
+    void Prefetch(const TArray<FString>& FilePaths);
+
+    /** Replaces the cached contents of a file, e.g. after it has been saved from the editor */
+    void UpdateDocument(const FString& FilePath, const FString& Content);
+
+    /** Drops a file from the cache */
+    void Invalidate(const FString& FilePath);
+
+    /** Converts a path to the form used as cache key, so paths reported by different tools compare equal */
+    static FString NormalizePath(const FString& FilePath);
+
+private:
+    struct FEntry
+    {
+        TSharedPtr<const FDreamerDocument> Document;
+        uint64 LastAccess = 0;
+    };
+
+    /** Returns the cached document if it is still current, must be called with the lock held */
+    TSharedPtr<const FDreamerDocument> FindCurrent(const FString& FilePath, const FDateTime& Timestamp);
+
+    /** Reads a file from disk without touching the cache */
+    static TSharedPtr<const FDreamerDocument> ReadDocument(const FString& FilePath);
+
+    /** Adds a document and evicts the least recently used one if over budget, must be called with the lock held */
+    void AddDocument(const FString& FilePath, const TSharedPtr<const FDreamerDocument>& Document);
+
+    /** Cached documents keyed by full path */
+    TMap<FString, FEntry> Entries;
+
+    /** Maximum number of documents kept in memory */
+    int32 MaxDocuments;
+
+    /** Monotonic counter used for least recently used eviction */
+    uint64 AccessCounter = 0;
+
+    /** Guards all of the above */
+    FCriticalSection Lock;
+};
@@ -21,8 +21,16 @@ public:
 	/** Opens the C++ editor tab */
 	void OpenCppEditorTab();
 
-	/** Opens a file at a specific location */
-	void OpenFileAtLocation(const FString& FilePath, int32 LineNumber);
+	/**
+	 * Opens a file at a specific location in the C++ editor tab, falling back to the external
+	 * source code accessor if the file cannot be opened there.
+	 * Without bActivate the editor is only updated if its tab is already open, and neither the tab
+	 * nor keyboard focus are brought to it.
+	 */
+	void OpenFileAtLocation(const FString& FilePath, int32 LineNumber, int32 ColumnNumber = 0, bool bActivate = true);
+
+	/** Loads files into the editor's document cache in the background, ahead of them being opened */
+	void PrefetchFiles(const TArray<FString>& FilePaths);
 
 private:
 	/** Registers menu extensions */
@@ -31,8 +39,16 @@ private:
 	/** Callback for spawning the build errors tab */
 	TSharedRef<class SDockTab> OnSpawnBuildErrorsTab(const class FSpawnTabArgs& SpawnTabArgs);
 
+	/** Console command handler that runs the build error list scroll benchmark */
+	void RunErrorListScrollBenchmark(const TArray<FString>& Args);
+
 private:
 	TSharedPtr<class FUICommandList> PluginCommands;
 	TSharedPtr<class FBuildManager> BuildManager;
 	TSharedPtr<class SBuildErrorList> BuildErrorList;
+	TSharedPtr<class FDreamerDocumentCache> DocumentCache;
+	TWeakPtr<class SDreamerCodeEditor> CodeEditor;
+
+	/** Registered console commands */
+	class IConsoleObject* ScrollBenchmarkCommand = nullptr;
 };
\ No newline at end of file
@@ -62,6 +62,9 @@ public class ImGui : ModuleRules
 				"CoreUObject",
 				"Engine",
 				"InputCore",
+				"Json",
+				"RenderCore",
+				"RHI",
 				"Slate",
 				"SlateCore"
 				// ... add private dependencies that you statically link with here ...	
@@ -5,16 +5,40 @@
 #include "ImGuiContextManager.h"
 
 #include "ImGuiDelegatesContainer.h"
+#include "ImGuiFontAtlasCache.h"
 #include "ImGuiImplementation.h"
 #include "Utilities/ScopeGuards.h"
 #include "Utilities/WorldContext.h"
 #include "Utilities/WorldContextIndex.h"
 
+#include <Async/ParallelFor.h>
+#include <Hash/CityHash.h>
+
 #include <imgui.h>
 
 
 // TODO: Refactor ImGui Context Manager, to handle different types of worlds.
 
+namespace CVars
+{
+	TAutoConsoleVariable<int> ParallelContextTick(TEXT("ImGui.ParallelContextTick"), 0,
+		TEXT("Render ImGui contexts in parallel on worker threads, after all draw events for the frame were called.\n")
+		TEXT("Only has an effect if there are at least two contexts to tick.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<FString> DynamicFontFile(TEXT("ImGui.DynamicFont.File"), TEXT(""),
+		TEXT("Path to a TrueType font file, absolute or relative to the project directory, with glyphs that extend the\n")
+		TEXT("default font. Glyphs are rasterized into the font atlas on their first use, so large character sets like CJK\n")
+		TEXT("only cost memory for glyphs that are displayed. The font is loaded once, when this is first set."),
+		ECVF_Default);
+}
+
+#if IMGUI_MODULE_DEVELOPER
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiContextManager, Log, All);
+#endif // IMGUI_MODULE_DEVELOPER
+
 namespace
 {
 #if WITH_EDITOR
@@ -61,9 +85,12 @@ namespace
 
 FImGuiContextManager::FImGuiContextManager()
 {
-	unsigned char* Pixels;
-	int Width, Height, Bpp;
-	FontAtlas.GetTexDataAsRGBA32(&Pixels, &Width, &Height, &Bpp);
+	DynamicFont.Reserve(FontAtlas);
+
+	// Fonts are only rasterized when their configuration changed, otherwise the atlas is loaded from cache.
+	// Only alpha data are kept in CPU memory. RGBA32 data would take 4 times more memory for the same coverage. The
+	// texture created from them is still RGBA (see FTextureManager::CreateTextureFromAlpha).
+	ImGuiFontAtlasCache::Build(FontAtlas);
 
 	FWorldDelegates::OnWorldTickStart.AddRaw(this, &FImGuiContextManager::OnWorldTickStart);
 #if ENGINE_COMPATIBILITY_WITH_WORLD_POST_ACTOR_TICK
@@ -78,6 +105,10 @@ FImGuiContextManager::~FImGuiContextManager()
 #if ENGINE_COMPATIBILITY_WITH_WORLD_POST_ACTOR_TICK
 	FWorldDelegates::OnWorldPostActorTick.RemoveAll(this);
 #endif
+
+	// Contexts are destroyed after this, so this is the last chance to save their settings.
+	SaveIniSettings(true);
+	IniWriter.Flush(true);
 }
 
 void FImGuiContextManager::Tick(float DeltaSeconds)
@@ -85,12 +116,20 @@ void FImGuiContextManager::Tick(float DeltaSeconds)
 	// In editor, worlds can get invalid. We could remove corresponding entries, but that would mean resetting ImGui
 	// context every time when PIE session is restarted. Instead we freeze contexts until their worlds are re-created.
 
+	// Draw events are called and frames are ended on the game thread for all contexts before any of them is rendered,
+	// so when rendering in parallel, contexts only touch their own state and read the shared font atlas (ending a
+	// frame unlocks the atlas).
+	TArray<FImGuiContextProxy*, TInlineAllocator<8>> ContextsToRender;
+
 	for (auto& Pair : Contexts)
 	{
 		auto& ContextData = Pair.Value;
 		if (ContextData.CanTick())
 		{
-			ContextData.ContextProxy->Tick(DeltaSeconds);
+			if (ContextData.ContextProxy->StartTick())
+			{
+				ContextsToRender.Add(ContextData.ContextProxy.Get());
+			}
 		}
 		else
 		{
@@ -98,6 +137,96 @@ void FImGuiContextManager::Tick(float DeltaSeconds)
 			FImGuiDelegatesContainer::Get().OnWorldDebug(Pair.Key).Clear();
 		}
 	}
+
+	if (CVars::ParallelContextTick.GetValueOnGameThread() > 0 && ContextsToRender.Num() > 1)
+	{
+		ParallelFor(ContextsToRender.Num(), [&ContextsToRender](int32 Index)
+		{
+			// Parallel iterations can also run on this thread, so switching contexts needs to be local to the task.
+			ImGuiImplementation::FScopedThreadContext ThreadContext;
+			ContextsToRender[Index]->RenderFrame();
+		});
+	}
+	else
+	{
+		for (FImGuiContextProxy* ContextProxy : ContextsToRender)
+		{
+			ContextProxy->RenderFrame();
+		}
+	}
+
+	// Glyphs can be only added between frames, when they are not used by any context.
+	UpdateDynamicFont();
+
+	for (FImGuiContextProxy* ContextProxy : ContextsToRender)
+	{
+		ContextProxy->FinishTick(DeltaSeconds);
+	}
+
+	// Contexts request saving in NewFrame, which is called when finishing the tick.
+	SaveIniSettings();
+	IniWriter.Flush();
+}
+
+void FImGuiContextManager::SaveIniSettings(bool bEvenIfNotRequested)
+{
+	// Checking settings switches contexts, but it shouldn't change the current context.
+	ImGuiImplementation::FScopedThreadContext ThreadContext;
+
+	for (auto& Pair : Contexts)
+	{
+		FImGuiContextProxy& ContextProxy = *Pair.Value.ContextProxy;
+
+		TArray<uint8> Data;
+		if (ContextProxy.SaveIniSettings(Data, bEvenIfNotRequested))
+		{
+			IniWriter.Queue(ContextProxy.GetIniFilePath(), MoveTemp(Data));
+		}
+	}
+}
+
+void FImGuiContextManager::UpdateDynamicFont()
+{
+	if (!DynamicFont.IsInitialized())
+	{
+		// Font is loaded once, but if it fails, a different file can be tried.
+		const FString FontFile = CVars::DynamicFontFile.GetValueOnGameThread();
+		if (FontFile.IsEmpty() || FontFile == DynamicFontFile || !FontAtlas.IsBuilt())
+		{
+			return;
+		}
+
+		DynamicFontFile = FontFile;
+		if (!DynamicFont.Initialize(FontFile))
+		{
+			return;
+		}
+	}
+
+	// Only changed draw data can have new glyphs.
+	for (auto& Pair : Contexts)
+	{
+		FContextData& ContextData = Pair.Value;
+		const uint32 DrawDataVersion = ContextData.ContextProxy->GetDrawDataVersion();
+		if (ContextData.ScannedDrawDataVersion != DrawDataVersion)
+		{
+			ContextData.ScannedDrawDataVersion = DrawDataVersion;
+			DynamicFont.CollectRequests(ContextData.ContextProxy->GetDrawData());
+		}
+	}
+
+	FIntRect DirtyRect;
+	bool bResized;
+	if (DynamicFont.RasterizeRequests(DirtyRect, bResized))
+	{
+		// Cached windows hold placeholders of new glyphs and, if the atlas grew, old texture and texture coordinates.
+		for (auto& Pair : Contexts)
+		{
+			Pair.Value.ContextProxy->GetWindowCache().InvalidateAll();
+		}
+
+		FontAtlasUpdatedEvent.Broadcast(DirtyRect, bResized);
+	}
 }
 
 #if ENGINE_COMPATIBILITY_LEGACY_WORLD_ACTOR_TICK
@@ -221,3 +350,166 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetWorldContextData(co
 	}
 	return *Data;
 }
+
+
+//----------------------------------------------------------------------------------------------------
+// Developer tests
+//----------------------------------------------------------------------------------------------------
+
+#if IMGUI_MODULE_DEVELOPER
+
+namespace
+{
+	// Draws content that only depends on context and frame indices. It doesn't use the demo window, because it keeps
+	// part of its state in static variables shared by all contexts.
+	void DrawDeterminismTestFrame(int32 ContextIndex, int32 FrameIndex)
+	{
+		ImGui::SetNextWindowPos({ 20.f + ContextIndex * 15.f, 20.f }, ImGuiCond_Always);
+		ImGui::SetNextWindowSize({ 600.f, 400.f + FrameIndex * 2.f }, ImGuiCond_Always);
+		ImGui::Begin("Determinism Test");
+
+		float Value = FrameIndex * 0.25f;
+		ImGui::SliderFloat("Value", &Value, 0.f, 100.f);
+
+		constexpr int32 NumSamples = 32;
+		float Samples[NumSamples];
+		for (int32 Index = 0; Index < NumSamples; Index++)
+		{
+			Samples[Index] = FMath::Sin((Index + FrameIndex + ContextIndex) * 0.3f);
+		}
+		ImGui::PlotLines("Samples", Samples, NumSamples);
+
+		for (int32 Row = 0; Row < 40; Row++)
+		{
+			ImGui::PushID(Row);
+			ImGui::Text("Context %d, frame %d, row %d", ContextIndex, FrameIndex, Row);
+			ImGui::SameLine();
+			ImGui::Button("Button");
+			ImGui::PopID();
+		}
+
+		ImGui::End();
+	}
+
+	// Renders the same frames in a number of independent contexts, either serially or in parallel, and returns
+	// checksums of the draw data of every context in every frame.
+	TArray<uint64> RunDeterminismTest(ImFontAtlas& FontAtlas, int32 NumContexts, int32 NumFrames, bool bParallel)
+	{
+		TArray<ImGuiContext*> TestContexts;
+		for (int32 ContextIndex = 0; ContextIndex < NumContexts; ContextIndex++)
+		{
+			ImGuiContext* Context = ImGui::CreateContext(&FontAtlas);
+			ImGui::SetCurrentContext(Context);
+			ImGui::GetIO().IniFilename = nullptr;
+			ImGui::GetIO().DisplaySize = { 1920.f, 1080.f };
+			TestContexts.Add(Context);
+		}
+
+		TArray<uint64> Checksums;
+		Checksums.SetNumZeroed(NumContexts * NumFrames);
+
+		TArray<FImGuiDrawList> DrawLists;
+		DrawLists.SetNum(NumContexts);
+
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+		{
+			// Like in the context manager, content is drawn and frames are ended serially and only rendering is done in parallel.
+			for (int32 ContextIndex = 0; ContextIndex < NumContexts; ContextIndex++)
+			{
+				ImGui::SetCurrentContext(TestContexts[ContextIndex]);
+				ImGui::GetIO().DeltaTime = 1.f / 60.f;
+				ImGui::NewFrame();
+				DrawDeterminismTestFrame(ContextIndex, FrameIndex);
+				ImGui::EndFrame();
+			}
+
+			auto RenderContext = [&](int32 ContextIndex)
+			{
+				ImGui::SetCurrentContext(TestContexts[ContextIndex]);
+				ImGui::Render();
+
+				const ImDrawData* DrawData = ImGui::GetDrawData();
+				uint64 Checksum = 0;
+				for (int32 Index = 0; Index < DrawData->CmdListsCount; Index++)
+				{
+					DrawLists[ContextIndex].CopyDrawData(*DrawData->CmdLists[Index]);
+					const uint64 ListChecksum = DrawLists[ContextIndex].CalculateChecksum();
+					Checksum = CityHash64WithSeed(reinterpret_cast<const char*>(&ListChecksum), sizeof(ListChecksum), Checksum);
+				}
+				Checksums[FrameIndex * NumContexts + ContextIndex] = Checksum;
+			};
+
+			if (bParallel)
+			{
+				ParallelFor(NumContexts, [&RenderContext](int32 ContextIndex)
+				{
+					ImGuiImplementation::FScopedThreadContext ThreadContext;
+					RenderContext(ContextIndex);
+				});
+			}
+			else
+			{
+				for (int32 ContextIndex = 0; ContextIndex < NumContexts; ContextIndex++)
+				{
+					RenderContext(ContextIndex);
+				}
+			}
+		}
+
+		for (ImGuiContext* Context : TestContexts)
+		{
+			ImGui::DestroyContext(Context);
+		}
+
+		return Checksums;
+	}
+
+	void TestParallelTickDeterminism(const TArray<FString>& Args)
+	{
+		const int32 NumContexts = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 2) : 4;
+		const int32 NumFrames = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 60;
+
+		// Test contexts must not replace the current context of the module.
+		ImGuiContext* PreviousContext = ImGui::GetCurrentContext();
+
+		ImFontAtlas FontAtlas;
+		unsigned char* Pixels;
+		int Width, Height;
+		FontAtlas.GetTexDataAsAlpha8(&Pixels, &Width, &Height);
+
+		const TArray<uint64> SerialChecksums = RunDeterminismTest(FontAtlas, NumContexts, NumFrames, false);
+		const TArray<uint64> ParallelChecksums = RunDeterminismTest(FontAtlas, NumContexts, NumFrames, true);
+
+		ImGui::SetCurrentContext(PreviousContext);
+
+		int32 NumMismatches = 0;
+		for (int32 Index = 0; Index < SerialChecksums.Num(); Index++)
+		{
+			if (SerialChecksums[Index] != ParallelChecksums[Index])
+			{
+				NumMismatches++;
+				UE_LOG(LogImGuiContextManager, Error, TEXT("Context %d, frame %d: serial checksum 0x%016llx, parallel checksum 0x%016llx."),
+					Index % NumContexts, Index / NumContexts, SerialChecksums[Index], ParallelChecksums[Index]);
+			}
+		}
+
+		if (NumMismatches > 0)
+		{
+			UE_LOG(LogImGuiContextManager, Error, TEXT("Parallel rendering differs from serial rendering in %d of %d frames."),
+				NumMismatches, SerialChecksums.Num());
+		}
+		else
+		{
+			UE_LOG(LogImGuiContextManager, Display, TEXT("Parallel rendering of %d contexts in %d frames is identical to serial rendering."),
+				NumContexts, NumFrames);
+		}
+	}
+
+	FAutoConsoleCommand TestParallelTickDeterminismCommand(TEXT("ImGui.Debug.TestParallelTickDeterminism"),
+		TEXT("Render the same frames in independent ImGui contexts serially and in parallel, and verify that both give\n")
+		TEXT("identical draw data.\n")
+		TEXT("Arguments: [NumContexts] [NumFrames] (defaults 4 and 60)"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&TestParallelTickDeterminism));
+}
+
+#endif // IMGUI_MODULE_DEVELOPER
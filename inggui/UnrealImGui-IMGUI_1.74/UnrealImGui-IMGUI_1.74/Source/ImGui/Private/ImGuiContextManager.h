@@ -3,6 +3,8 @@
 #pragma once
 
 #include "ImGuiContextProxy.h"
+#include "ImGuiDynamicFont.h"
+#include "ImGuiIniWriter.h"
 
 
 // TODO: It might be useful to broadcast FContextProxyCreatedDelegate to users, to support similar cases to our ImGui
@@ -13,6 +15,11 @@
 // @param ContextProxy - Created context proxy
 DECLARE_MULTICAST_DELEGATE_TwoParams(FContextProxyCreatedDelegate, int32, FImGuiContextProxy&);
 
+// Delegate called when glyphs were added to the font atlas, before contexts begin a new frame.
+// @param DirtyRect - Area of the atlas with new glyphs
+// @param bResized - Whether the atlas size changed, in which case the whole texture needs to be recreated
+DECLARE_MULTICAST_DELEGATE_TwoParams(FFontAtlasUpdatedDelegate, const FIntRect&, bool);
+
 // Manages ImGui context proxies.
 class FImGuiContextManager
 {
@@ -31,6 +38,10 @@ public:
 	ImFontAtlas& GetFontAtlas() { return FontAtlas; }
 	const ImFontAtlas& GetFontAtlas() const { return FontAtlas; }
 
+	// Get the font with glyphs rasterized on demand (see ImGui.DynamicFont.File).
+	FImGuiDynamicFont& GetDynamicFont() { return DynamicFont; }
+	const FImGuiDynamicFont& GetDynamicFont() const { return DynamicFont; }
+
 
 #if WITH_EDITOR
 	// Get or create editor ImGui context proxy.
@@ -62,6 +73,29 @@ public:
 	// Delegate called when new context proxy is created.
 	FContextProxyCreatedDelegate& OnContextProxyCreated() { return ContextProxyCreatedEvent; }
 
+	// Delegate called when glyphs were added to the font atlas and its texture needs to be updated.
+	FFontAtlasUpdatedDelegate& OnFontAtlasUpdated() { return FontAtlasUpdatedEvent; }
+
+	// Call a function for every context proxy in this manager.
+	// @param Function - Function called with context index and proxy
+	template<typename FunctionType>
+	void ForEachContextProxy(FunctionType&& Function) const
+	{
+		for (const auto& Pair : Contexts)
+		{
+			Function(Pair.Key, static_cast<const FImGuiContextProxy&>(*Pair.Value.ContextProxy));
+		}
+	}
+
+	template<typename FunctionType>
+	void ForEachContextProxy(FunctionType&& Function)
+	{
+		for (const auto& Pair : Contexts)
+		{
+			Function(Pair.Key, *Pair.Value.ContextProxy);
+		}
+	}
+
 	void Tick(float DeltaSeconds);
 
 private:
@@ -78,6 +112,9 @@ private:
 
 		int32 PIEInstance = -1;
 		TUniquePtr<FImGuiContextProxy> ContextProxy;
+
+		// Version of draw data that was last scanned for dynamic font glyphs.
+		uint32 ScannedDrawDataVersion = 0;
 	};
 
 #if ENGINE_COMPATIBILITY_LEGACY_WORLD_ACTOR_TICK
@@ -99,11 +136,24 @@ private:
 
 	FContextData& GetWorldContextData(const UWorld& World, int32* OutContextIndex = nullptr);
 
+	void UpdateDynamicFont();
+
+	// Queue changed settings of all contexts to be written.
+	// @param bEvenIfNotRequested - If true, settings are checked even if contexts didn't request saving them
+	void SaveIniSettings(bool bEvenIfNotRequested = false);
+
 	TMap<int32, FContextData> Contexts;
 
 	FSimpleMulticastDelegate DrawMultiContextEvent;
 
 	FContextProxyCreatedDelegate ContextProxyCreatedEvent;
 
+	FFontAtlasUpdatedDelegate FontAtlasUpdatedEvent;
+
 	ImFontAtlas FontAtlas;
+
+	FImGuiDynamicFont DynamicFont;
+	FString DynamicFontFile;
+
+	FImGuiIniWriter IniWriter;
 };
@@ -9,6 +9,7 @@
 #include "ImGuiInteroperability.h"
 #include "Utilities/Arrays.h"
 
+#include <Misc/FileHelper.h>
 #include <Runtime/Launch/Resources/Version.h>
 
 
@@ -16,8 +17,38 @@ static constexpr float DEFAULT_CANVAS_WIDTH = 3840.f;
 static constexpr float DEFAULT_CANVAS_HEIGHT = 2160.f;
 
 
+namespace CVars
+{
+	TAutoConsoleVariable<int> PipelinedDrawData(TEXT("ImGui.PipelinedDrawData"), 0,
+		TEXT("Prepare Slate draw data on a worker thread while the next ImGui frame is built. Adds one frame of\n")
+		TEXT("latency to ImGui output.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+}
+
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Unchanged Frames"), STAT_ImGuiUnchangedFrames, STATGROUP_ImGui);
+
+DECLARE_CYCLE_STAT(TEXT("NewFrame"), STAT_ImGuiNewFrame, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Draw Events"), STAT_ImGuiDrawEvents, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Render"), STAT_ImGuiRender, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Transfer"), STAT_ImGuiTransfer, STATGROUP_ImGui);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Draw Lists"), STAT_ImGuiDrawLists, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Draw Commands"), STAT_ImGuiDrawCommands, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vertices"), STAT_ImGuiVertices, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Indices"), STAT_ImGuiIndices, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Allocations"), STAT_ImGuiAllocations, STATGROUP_ImGui);
+
+
 namespace
 {
+	// Proxies by their ImGui contexts, so module functions called during drawing can find the proxy of the current
+	// context. Contexts can be updated on different threads, so access is guarded.
+	TMap<ImGuiContext*, FImGuiContextProxy*> ContextProxies;
+	FRWLock ContextProxiesLock;
+
 	FString GetSaveDirectory()
 	{
 #if ENGINE_COMPATIBILITY_LEGACY_SAVED_DIR
@@ -45,19 +76,28 @@ FImGuiContextProxy::FImGuiContextProxy(const FString& InName, int32 InContextInd
 	: Name(InName)
 	, ContextIndex(InContextIndex)
 	, SharedDrawEvent(InSharedDrawEvent)
-	, IniFilename(TCHAR_TO_ANSI(*GetIniFile(InName)))
+	, IniFilePath(GetIniFile(InName))
 {
 	// Create context.
 	Context = ImGui::CreateContext(InFontAtlas);
 
+	{
+		FRWScopeLock Lock(ContextProxiesLock, SLT_Write);
+		ContextProxies.Add(Context, this);
+	}
+
 	// Set this context in ImGui for initialization (any allocations will be tracked in this context).
 	SetAsCurrent();
 
 	// Start initialization.
 	ImGuiIO& IO = ImGui::GetIO();
 
-	// Set session data storage.
-	IO.IniFilename = IniFilename.c_str();
+	// Settings are loaded here and saved by the context manager, so ImGui doesn't access files during frames.
+	IO.IniFilename = nullptr;
+	if (FFileHelper::LoadFileToArray(SavedIniData, *IniFilePath, FILEREAD_Silent) && SavedIniData.Num() > 0)
+	{
+		ImGui::LoadIniSettingsFromMemory(reinterpret_cast<const char*>(SavedIniData.GetData()), SavedIniData.Num());
+	}
 
 	// Use pre-defined canvas size.
 	IO.DisplaySize = { DEFAULT_CANVAS_WIDTH, DEFAULT_CANVAS_HEIGHT };
@@ -73,23 +113,111 @@ FImGuiContextProxy::FImGuiContextProxy(const FString& InName, int32 InContextInd
 
 FImGuiContextProxy::~FImGuiContextProxy()
 {
+	// Worker may still read our draw lists.
+	FinishPreparingDrawData();
+
 	if (Context)
 	{
+		{
+			FRWScopeLock Lock(ContextProxiesLock, SLT_Write);
+			ContextProxies.Remove(Context);
+		}
+
 		// It seems that to properly shutdown context we need to set it as the current one (at least in this framework
 		// version), even though we can pass it to the destroy function.
 		SetAsCurrent();
 
-		// Save context data and destroy.
+		// Destroy context (settings are saved by the context manager).
 		ImGui::DestroyContext(Context);
 	}
 }
 
+void FImGuiContextProxy::StartInputRecording()
+{
+	InputRecorder = MakeUnique<FImGuiInputRecorder>();
+}
+
+bool FImGuiContextProxy::StopInputRecording(FImGuiInputStream& OutStream)
+{
+	if (!InputRecorder)
+	{
+		return false;
+	}
+
+	OutStream = InputRecorder->GetStream();
+	InputRecorder.Reset();
+	return true;
+}
+
+void FImGuiContextProxy::StartInputReplay(const FImGuiInputStream& Stream, bool bLoop)
+{
+	if (Stream.GetNumFrames() > 0)
+	{
+		InputReplay = MakeUnique<FInputReplay>();
+		InputReplay->Stream = Stream;
+		InputReplay->bLoop = bLoop;
+	}
+}
+
+void FImGuiContextProxy::StopInputReplay()
+{
+	if (InputReplay)
+	{
+		InputReplay.Reset();
+
+		// Reset live input and mark it as dirty, so keys and buttons pressed during replay are released in ImGui.
+		InputState.Reset();
+	}
+}
+
+bool FImGuiContextProxy::SaveIniSettings(TArray<uint8>& OutData, bool bEvenIfNotRequested)
+{
+	SetAsCurrent();
+
+	ImGuiIO& IO = ImGui::GetIO();
+	if (!IO.WantSaveIniSettings && !bEvenIfNotRequested)
+	{
+		return false;
+	}
+
+	IO.WantSaveIniSettings = false;
+
+	size_t Size = 0;
+	const char* Data = ImGui::SaveIniSettingsToMemory(&Size);
+
+	// ImGui requests saving after any change in windows, even if it doesn't change settings, like moving a window back.
+	if (static_cast<size_t>(SavedIniData.Num()) == Size && FMemory::Memcmp(SavedIniData.GetData(), Data, Size) == 0)
+	{
+		return false;
+	}
+
+	SavedIniData = TArray<uint8>(reinterpret_cast<const uint8*>(Data), static_cast<int32>(Size));
+	OutData = SavedIniData;
+	return true;
+}
+
+FImGuiContextProxy* FImGuiContextProxy::GetCurrentContextProxy()
+{
+	ImGuiContext* CurrentContext = ImGui::GetCurrentContext();
+	if (!CurrentContext)
+	{
+		return nullptr;
+	}
+
+	FRWScopeLock Lock(ContextProxiesLock, SLT_ReadOnly);
+	FImGuiContextProxy* const* ContextProxy = ContextProxies.Find(CurrentContext);
+	return ContextProxy ? *ContextProxy : nullptr;
+}
+
 void FImGuiContextProxy::DrawEarlyDebug()
 {
 	if (bIsFrameStarted && !bIsDrawEarlyDebugCalled)
 	{
 		bIsDrawEarlyDebugCalled = true;
 
+		SCOPE_CYCLE_COUNTER(STAT_ImGuiDrawEvents);
+		FImGuiContextStatsScope StatsScope{ Stats, FImGuiContextStats::ETimer::DrawEvents };
+
 		SetAsCurrent();
 
 		// Delegates called in order specified in FImGuiDelegates.
@@ -107,6 +235,9 @@ void FImGuiContextProxy::DrawDebug()
 		// Make sure that early debug is always called first to guarantee order specified in FImGuiDelegates.
 		DrawEarlyDebug();
 
+		SCOPE_CYCLE_COUNTER(STAT_ImGuiDrawEvents);
+		FImGuiContextStatsScope StatsScope{ Stats, FImGuiContextStats::ETimer::DrawEvents };
+
 		SetAsCurrent();
 
 		// Delegates called in order specified in FImGuiDelegates.
@@ -116,34 +247,81 @@ void FImGuiContextProxy::DrawDebug()
 }
 
 void FImGuiContextProxy::Tick(float DeltaSeconds)
+{
+	if (StartTick())
+	{
+		RenderFrame();
+		FinishTick(DeltaSeconds);
+	}
+}
+
+bool FImGuiContextProxy::StartTick()
 {
 	// Making sure that we tick only once per frame.
 	if (LastFrameNumber < GFrameNumber)
 	{
 		LastFrameNumber = GFrameNumber;
 
-		SetAsCurrent();
+		const uint32 NumAllocationsBefore = ImGuiImplementation::GetNumThreadAllocations();
+
+		// Make sure that draw events are called before the end of the frame.
+		DrawDebug();
 
+		// Ending the frame unlocks the shared font atlas, so it is done here on the game thread rather than in
+		// RenderFrame. Rendering skips ending the frame when it was already ended.
 		if (bIsFrameStarted)
 		{
-			// Make sure that draw events are called before the end of the frame.
-			DrawDebug();
-
-			// Ending frame will produce render output that we capture and store for later use. This also puts context to
-			// state in which it does not allow to draw controls, so we want to immediately start a new frame.
-			EndFrame();
+			SetAsCurrent();
+			ImGui::EndFrame();
 		}
 
-		// Update context information (some data, like mouse cursor, may be cleaned in new frame, so we should collect it
-		// beforehand).
-		bHasActiveItem = ImGui::IsAnyItemActive();
-		bIsMouseHoveringAnyWindow = ImGui::IsWindowHovered(ImGuiHoveredFlags_AnyWindow);
-		MouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
-		DisplaySize = ImGuiInterops::ToVector2D(ImGui::GetIO().DisplaySize);
-
-		// Begin a new frame and set the context back to a state in which it allows to draw controls.
-		BeginFrame(DeltaSeconds);
+		CountAllocations(NumAllocationsBefore);
+		return true;
 	}
+
+	return false;
+}
+
+void FImGuiContextProxy::RenderFrame()
+{
+	const uint32 NumAllocationsBefore = ImGuiImplementation::GetNumThreadAllocations();
+
+	SetAsCurrent();
+
+	// Ending frame will produce render output that we capture and store for later use. This also puts context to
+	// state in which it does not allow to draw controls, so we want to immediately start a new frame.
+	EndFrame();
+
+	CountAllocations(NumAllocationsBefore);
+}
+
+void FImGuiContextProxy::FinishTick(float DeltaSeconds)
+{
+	const uint32 NumAllocationsBefore = ImGuiImplementation::GetNumThreadAllocations();
+
+	SetAsCurrent();
+
+	// Preparation reads console variables, so it is started here rather than in RenderFrame.
+	StartPreparingDrawData();
+
+	// Update context information (some data, like mouse cursor, may be cleaned in new frame, so we should collect it
+	// beforehand).
+	bHasActiveItem = ImGui::IsAnyItemActive();
+	bIsMouseHoveringAnyWindow = ImGui::IsWindowHovered(ImGuiHoveredFlags_AnyWindow);
+	MouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
+	DisplaySize = ImGuiInterops::ToVector2D(ImGui::GetIO().DisplaySize);
+
+	// Begin a new frame and set the context back to a state in which it allows to draw controls.
+	BeginFrame(DeltaSeconds);
+
+	CountAllocations(NumAllocationsBefore);
+}
+
+void FImGuiContextProxy::CountAllocations(uint32 NumAllocationsBefore)
+{
+	const uint32 NumAllocations = ImGuiImplementation::GetNumThreadAllocations() - NumAllocationsBefore;
+	Stats.AddCount(FImGuiContextStats::ECounter::Allocations, NumAllocations);
+	INC_DWORD_STAT_BY(STAT_ImGuiAllocations, NumAllocations);
 }
 
 void FImGuiContextProxy::BeginFrame(float DeltaTime)
@@ -153,10 +331,47 @@ void FImGuiContextProxy::BeginFrame(float DeltaTime)
 		ImGuiIO& IO = ImGui::GetIO();
 		IO.DeltaTime = DeltaTime;
 
-		ImGuiInterops::CopyInput(IO, InputState);
-		InputState.ClearUpdateState();
+		{
+			FImGuiContextStatsScope StatsScope{ Stats, FImGuiContextStats::ETimer::Input };
+
+			if (InputReplay && InputReplay->Frame == InputReplay->Stream.GetNumFrames() && !InputReplay->bLoop)
+			{
+				StopInputReplay();
+			}
+
+			const FImGuiInputState::FAppliedEvents AppliedEvents = InputState.ApplyQueuedEvents();
+
+			if (InputReplay)
+			{
+				// Live input is still applied to keep the queue short, but it doesn't reach ImGui.
+				InputState.ClearUpdateState();
+				ApplyReplayedInput(IO);
+			}
+			else
+			{
+				if (InputRecorder)
+				{
+					InputRecorder->RecordFrame(DeltaTime, InputState);
+				}
+
+				ImGuiInterops::CopyInput(IO, InputState);
+				InputState.ClearUpdateState();
+			}
+
+			Stats.AddCount(FImGuiContextStats::ECounter::InputEvents, AppliedEvents.NumApplied);
+			Stats.AddCount(FImGuiContextStats::ECounter::CoalescedInputEvents, AppliedEvents.NumCoalesced);
+			if (AppliedEvents.NumApplied > 0)
+			{
+				// Time since the oldest event applied in this frame was received.
+				Stats.AddTime(FImGuiContextStats::ETimer::InputLatency, FPlatformTime::Seconds() - AppliedEvents.OldestTimestamp);
+			}
+		}
 
-		ImGui::NewFrame();
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ImGuiNewFrame);
+			FImGuiContextStatsScope StatsScope{ Stats, FImGuiContextStats::ETimer::NewFrame };
+			ImGui::NewFrame();
+		}
 
 		bIsFrameStarted = true;
 		bIsDrawEarlyDebugCalled = false;
@@ -164,12 +379,37 @@ void FImGuiContextProxy::BeginFrame(float DeltaTime)
 	}
 }
 
+void FImGuiContextProxy::ApplyReplayedInput(ImGuiIO& IO)
+{
+	FInputReplay& Replay = *InputReplay;
+	if (Replay.Frame == Replay.Stream.GetNumFrames())
+	{
+		// Restart from the same input state that recording started with.
+		Replay.Frame = 0;
+		Replay.InputState.Reset();
+	}
+
+	Replay.InputState.SetKeyboardNavigationEnabled(InputState.IsKeyboardNavigationEnabled());
+
+	IO.DeltaTime = Replay.Stream.GetDeltaSeconds(Replay.Frame);
+	Replay.Stream.Apply(Replay.Frame, Replay.InputState);
+	Replay.InputState.ApplyQueuedEvents();
+	ImGuiInterops::CopyInput(IO, Replay.InputState);
+	Replay.InputState.ClearUpdateState();
+
+	Replay.Frame++;
+}
+
 void FImGuiContextProxy::EndFrame()
 {
 	if (bIsFrameStarted)
 	{
 		// Prepare draw data (after this call we cannot draw to this context until we start a new frame).
-		ImGui::Render();
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ImGuiRender);
+			FImGuiContextStatsScope StatsScope{ Stats, FImGuiContextStats::ETimer::Render };
+			ImGui::Render();
+		}
 
 		// Update our draw data, so we can use them later during Slate rendering while ImGui is in the middle of the
 		// next frame.
@@ -181,19 +421,116 @@ void FImGuiContextProxy::EndFrame()
 
 void FImGuiContextProxy::UpdateDrawData(ImDrawData* DrawData)
 {
-	if (DrawData && DrawData->CmdListsCount > 0)
+	SCOPE_CYCLE_COUNTER(STAT_ImGuiTransfer);
+	FImGuiContextStatsScope StatsScope{ Stats, FImGuiContextStats::ETimer::Transfer };
+
+	// Copy to the set of draw lists that is not read by the worker preparing the last frame. Sets and lists in them
+	// are never released, so in steady state copying doesn't need to allocate.
+	CurrentDrawListSet = 1 - CurrentDrawListSet;
+	FDrawListSet& DrawListSet = DrawListSets[CurrentDrawListSet];
+
+	DrawListSet.Num = DrawData ? DrawData->CmdListsCount : 0;
+	if (DrawListSet.Lists.Num() < DrawListSet.Num)
+	{
+		DrawListSet.Lists.SetNum(DrawListSet.Num);
+	}
+
+	for (int32 Index = 0; Index < DrawListSet.Num; Index++)
+	{
+		DrawListSet.Lists[Index].CopyDrawData(*DrawData->CmdLists[Index]);
+	}
+
+	const TArrayView<const FImGuiDrawList> DrawLists = GetDrawData();
+
+	int32 NumDrawCommands = 0;
+	int32 NumVertices = 0;
+	int32 NumIndices = 0;
+	for (const FImGuiDrawList& DrawList : DrawLists)
+	{
+		NumDrawCommands += DrawList.NumCommands();
+		NumVertices += DrawList.NumVertices();
+		NumIndices += DrawList.NumIndices();
+	}
+
+	Stats.AddCount(FImGuiContextStats::ECounter::DrawLists, DrawLists.Num());
+	Stats.AddCount(FImGuiContextStats::ECounter::DrawCommands, NumDrawCommands);
+	Stats.AddCount(FImGuiContextStats::ECounter::Vertices, NumVertices);
+	Stats.AddCount(FImGuiContextStats::ECounter::Indices, NumIndices);
+	INC_DWORD_STAT_BY(STAT_ImGuiDrawLists, DrawLists.Num());
+	INC_DWORD_STAT_BY(STAT_ImGuiDrawCommands, NumDrawCommands);
+	INC_DWORD_STAT_BY(STAT_ImGuiVertices, NumVertices);
+	INC_DWORD_STAT_BY(STAT_ImGuiIndices, NumIndices);
+
+	// Compare with signatures from the previous frame to detect unchanged draw data.
+	bDrawDataChanged = DrawLists.Num() != DrawListSignatures.Num();
+	DrawListSignatures.SetNum(DrawLists.Num(), false);
+	for (int32 Index = 0; Index < DrawLists.Num(); Index++)
+	{
+		if (DrawLists[Index].UpdateSignature(DrawListSignatures[Index]))
+		{
+			bDrawDataChanged = true;
+		}
+	}
+
+	if (bDrawDataChanged)
 	{
-		DrawLists.SetNum(DrawData->CmdListsCount, false);
+		DrawDataVersion++;
+	}
+	else
+	{
+		NumUnchangedFrames++;
+		INC_DWORD_STAT(STAT_ImGuiUnchangedFrames);
+	}
+}
 
-		for (int Index = 0; Index < DrawData->CmdListsCount; Index++)
+void FImGuiContextProxy::StartPreparingDrawData()
+{
+	// Worker from the previous frame needs to finish before we can reuse its buffers.
+	FinishPreparingDrawData();
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	// We can only prepare data after the widget told us what transform it uses.
+	if (CVars::PipelinedDrawData.GetValueOnGameThread() > 0 && DrawTransform.IsSet())
+	{
+		// If neither draw data nor transform and culling rectangle changed, data in the front buffer are still valid.
+		const FImGuiSlateDrawData& FrontDrawData = PreparedDrawData[FrontDrawDataIndex];
+		if (!bDrawDataChanged && bHasPreparedDrawData && FrontDrawData.Transform == DrawTransform.GetValue()
+			&& FrontDrawData.CullingRect == DrawCullingRect)
 		{
-			DrawLists[Index].TransferDrawData(*DrawData->CmdLists[Index]);
+			return;
 		}
+
+		const int32 BackDrawDataIndex = 1 - FrontDrawDataIndex;
+		const FSlateRenderTransform Transform = DrawTransform.GetValue();
+		const FSlateRect CullingRect = DrawCullingRect;
+		const TArrayView<const FImGuiDrawList> DrawLists = GetDrawData();
+		PrepareDrawDataTask = FFunctionGraphTask::CreateAndDispatchWhenReady([this, BackDrawDataIndex, DrawLists, Transform, CullingRect]()
+		{
+			PreparedDrawData[BackDrawDataIndex].Prepare(DrawLists, Transform, CullingRect);
+		}, TStatId{}, nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
 	}
 	else
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	{
+		bHasPreparedDrawData = false;
+	}
+}
+
+void FImGuiContextProxy::FinishPreparingDrawData()
+{
+	if (PrepareDrawDataTask.IsValid())
 	{
-		// If we are not rendering then this might be a good moment to empty the array.
-		DrawLists.Empty();
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(PrepareDrawDataTask);
+		PrepareDrawDataTask.SafeRelease();
+
+		const FImGuiSlateDrawData& Prepared = PreparedDrawData[1 - FrontDrawDataIndex];
+		Stats.AddTime(FImGuiContextStats::ETimer::Conversion, Prepared.PrepareTime);
+		Stats.AddCount(FImGuiContextStats::ECounter::BytesConverted, Prepared.NumBytesConverted);
+		Stats.AddCount(FImGuiContextStats::ECounter::CulledDrawCommands, Prepared.NumCulledCommands);
+
+		// Prepared data become the front buffer.
+		FrontDrawDataIndex = 1 - FrontDrawDataIndex;
+		bHasPreparedDrawData = true;
 	}
 }
 
@@ -2,16 +2,19 @@
 
 #pragma once
 
+#include "ImGuiContextStats.h"
 #include "ImGuiDrawData.h"
+#include "ImGuiInputRecorder.h"
 #include "ImGuiInputState.h"
+#include "ImGuiInputStream.h"
+#include "ImGuiWindowCache.h"
 #include "Utilities/WorldContextIndex.h"
 
+#include <Async/TaskGraphInterfaces.h>
 #include <GenericPlatform/ICursor.h>
 
 #include <imgui.h>
 
-#include <string>
-
 
 // Represents a single ImGui context. All the context updates should be done through this proxy. During update it
 // broadcasts draw events to allow listeners draw their controls. After update it stores draw data.
@@ -32,12 +35,73 @@ public:
 	const FString& GetName() const { return Name; }
 
 	// Get draw data from the last frame.
-	const TArray<FImGuiDrawList>& GetDrawData() const { return DrawLists; }
+	TArrayView<const FImGuiDrawList> GetDrawData() const
+	{
+		const FDrawListSet& DrawListSet = DrawListSets[CurrentDrawListSet];
+		return { DrawListSet.Lists.GetData(), DrawListSet.Num };
+	}
+
+	// Get Slate draw data prepared on a worker thread, if pipelined preparation is enabled (see
+	// ImGui.PipelinedDrawData). Prepared data are one frame behind draw data and use the transform and culling
+	// rectangle from the last call to SetDrawTransform.
+	// @returns Prepared draw data or null, if there are no prepared data
+	const FImGuiSlateDrawData* GetPreparedDrawData() const { return bHasPreparedDrawData ? &PreparedDrawData[FrontDrawDataIndex] : nullptr; }
+
+	// Get version of draw data. It changes only if transferred draw data differ from the previous frame, so it can be
+	// used to skip converting unchanged data.
+	uint32 GetDrawDataVersion() const { return DrawDataVersion; }
+
+	// Get the number of frames in which draw data did not change.
+	uint32 GetNumUnchangedFrames() const { return NumUnchangedFrames; }
+
+	// Set transform from ImGui to screen space and screen space culling rectangle that should be used to prepare draw
+	// data on a worker thread.
+	void SetDrawTransform(const FSlateRenderTransform& Transform, const FSlateRect& CullingRect)
+	{
+		DrawTransform = Transform;
+		DrawCullingRect = CullingRect;
+	}
+
+	// Get timers and counters of this context.
+	FImGuiContextStats& GetStats() { return Stats; }
+	const FImGuiContextStats& GetStats() const { return Stats; }
+
+	// Get cache of windows drawn in this context.
+	FImGuiWindowCache& GetWindowCache() { return WindowCache; }
+	const FImGuiWindowCache& GetWindowCache() const { return WindowCache; }
+
+	// Get the proxy of the current ImGui context.
+	// @returns Proxy of the current context or null, if there is no current context
+	static FImGuiContextProxy* GetCurrentContextProxy();
 
 	// Get input state used by this context.
 	FImGuiInputState& GetInputState() { return InputState; }
 	const FImGuiInputState& GetInputState() const { return InputState; }
 
+	// Start recording live input applied in every frame, replacing any previous recording.
+	void StartInputRecording();
+
+	// Stop recording input.
+	// @param OutStream - Receives recorded input
+	// @returns True, if input was recorded and false, if recording was not started
+	bool StopInputRecording(FImGuiInputStream& OutStream);
+
+	// Check whether input is recorded.
+	bool IsRecordingInput() const { return InputRecorder.IsValid(); }
+
+	// Replay input from a stream instead of live input, starting from the next frame. Frames use delta times from the
+	// stream, so given the same initial context state, replay produces the same frames. Live input is ignored until
+	// replay ends and then it is reset.
+	// @param Stream - Input to replay
+	// @param bLoop - If true, replay restarts after the last frame, otherwise it ends
+	void StartInputReplay(const FImGuiInputStream& Stream, bool bLoop = false);
+
+	// Stop replaying input and return to live input.
+	void StopInputReplay();
+
+	// Check whether input is replayed.
+	bool IsReplayingInput() const { return InputReplay.IsValid(); }
+
 	// Is this context the current ImGui context.
 	bool IsCurrentContext() const { return ImGui::GetCurrentContext() == Context; }
 
@@ -65,9 +129,33 @@ public:
 	// Call debug events to allow listeners draw their debug widgets.
 	void DrawDebug();
 
+	// Get the path of the ini file with settings of this context.
+	const FString& GetIniFilePath() const { return IniFilePath; }
+
+	// Get settings of this context, if they changed since they were loaded or last saved. ImGui doesn't access ini
+	// files, so settings need to be saved by the owner.
+	// @param OutData - Receives content of the ini file
+	// @param bEvenIfNotRequested - If false, only settings that ImGui requested to save are checked, otherwise all
+	//     settings are checked, which can be used during shutdown
+	// @returns True, if settings changed and should be written to the ini file
+	bool SaveIniSettings(TArray<uint8>& OutData, bool bEvenIfNotRequested = false);
+
 	// Tick to advance context to the next frame. Only one call per frame will be processed.
 	void Tick(float DeltaSeconds);
 
+	// Tick split into stages, so different contexts can render in parallel. StartTick and FinishTick need to be called
+	// on the game thread, RenderFrame can be called on any thread inside of ImGuiImplementation::FScopedThreadContext.
+	// Calling them in sequence is equivalent to calling Tick. StartTick ends the ImGui frame, so RenderFrame doesn't
+	// write to the font atlas shared with other contexts.
+	// @returns True, if this context needs to be ticked in this frame and remaining stages should be called
+	bool StartTick();
+
+	// Render the current frame and update draw data. Only called after StartTick returned true.
+	void RenderFrame();
+
+	// Finish the tick and begin a new frame. Only called after RenderFrame.
+	void FinishTick(float DeltaSeconds);
+
 private:
 
 	void BeginFrame(float DeltaTime = 1.f / 60.f);
@@ -75,6 +163,11 @@ private:
 
 	void UpdateDrawData(ImDrawData* DrawData);
 
+	void ApplyReplayedInput(ImGuiIO& IO);
+
+	void StartPreparingDrawData();
+	void FinishPreparingDrawData();
+
 	void BroadcastWorldEarlyDebug();
 	void BroadcastMultiContextEarlyDebug();
 
@@ -95,7 +188,48 @@ private:
 
 	FImGuiInputState InputState;
 
-	TArray<FImGuiDrawList> DrawLists;
+	TUniquePtr<FImGuiInputRecorder> InputRecorder;
+
+	struct FInputReplay
+	{
+		FImGuiInputStream Stream;
+		FImGuiInputState InputState;
+		int32 Frame = 0;
+		bool bLoop = false;
+	};
+
+	TUniquePtr<FInputReplay> InputReplay;
+
+	FImGuiWindowCache WindowCache;
+
+	FImGuiContextStats Stats;
+
+	void CountAllocations(uint32 NumAllocationsBefore);
+
+	// Draw lists are double-buffered, so the worker can read lists from the last frame while we copy the next one.
+	// Lists are never released to keep their buffers, only the first Num lists in a set are valid.
+	struct FDrawListSet
+	{
+		TArray<FImGuiDrawList> Lists;
+		int32 Num = 0;
+	};
+
+	FDrawListSet DrawListSets[2];
+	int32 CurrentDrawListSet = 0;
+
+	// Signatures of draw lists from the last frame, used to detect unchanged frames.
+	TArray<FImGuiDrawListSignature> DrawListSignatures;
+	uint32 DrawDataVersion = 0;
+	uint32 NumUnchangedFrames = 0;
+	bool bDrawDataChanged = false;
+
+	// Double-buffered Slate draw data: the front buffer is used for drawing while the back buffer is prepared.
+	FImGuiSlateDrawData PreparedDrawData[2];
+	int32 FrontDrawDataIndex = 0;
+	bool bHasPreparedDrawData = false;
+	FGraphEventRef PrepareDrawDataTask;
+	TOptional<FSlateRenderTransform> DrawTransform;
+	FSlateRect DrawCullingRect;
 
 	FString Name;
 	int32 ContextIndex = Utilities::INVALID_CONTEXT_INDEX;
@@ -105,5 +239,8 @@ private:
 	FSimpleMulticastDelegate DrawEvent;
 	FSimpleMulticastDelegate* SharedDrawEvent = nullptr;
 
-	std::string IniFilename;
+	FString IniFilePath;
+
+	// Content of the ini file, as it was loaded or last saved.
+	TArray<uint8> SavedIniData;
 };
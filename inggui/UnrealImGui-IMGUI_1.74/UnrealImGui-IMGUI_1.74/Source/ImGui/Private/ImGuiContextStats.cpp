@@ -0,0 +1,39 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiContextStats.h"
+
+
+const TCHAR* FImGuiContextStats::GetName(ETimer Timer)
+{
+	switch (Timer)
+	{
+	case ETimer::Input: return TEXT("Input");
+	case ETimer::InputLatency: return TEXT("InputLatency");
+	case ETimer::NewFrame: return TEXT("NewFrame");
+	case ETimer::DrawEvents: return TEXT("DrawEvents");
+	case ETimer::Render: return TEXT("Render");
+	case ETimer::Transfer: return TEXT("Transfer");
+	case ETimer::Conversion: return TEXT("Conversion");
+	case ETimer::Paint: return TEXT("Paint");
+	default: return TEXT("Unknown");
+	}
+}
+
+const TCHAR* FImGuiContextStats::GetName(ECounter Counter)
+{
+	switch (Counter)
+	{
+	case ECounter::DrawLists: return TEXT("DrawLists");
+	case ECounter::DrawCommands: return TEXT("DrawCommands");
+	case ECounter::Vertices: return TEXT("Vertices");
+	case ECounter::Indices: return TEXT("Indices");
+	case ECounter::BytesConverted: return TEXT("BytesConverted");
+	case ECounter::CulledDrawCommands: return TEXT("CulledDrawCommands");
+	case ECounter::Allocations: return TEXT("Allocations");
+	case ECounter::InputEvents: return TEXT("InputEvents");
+	case ECounter::CoalescedInputEvents: return TEXT("CoalescedInputEvents");
+	default: return TEXT("Unknown");
+	}
+}
@@ -0,0 +1,112 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <CoreGlobals.h>
+#include <HAL/PlatformTime.h>
+
+
+// Timers and counters of a single ImGui context. Values are accumulated during an engine frame, and each of them holds
+// the total from the last frame in which it was updated.
+class FImGuiContextStats
+{
+public:
+
+	enum class ETimer : uint8
+	{
+		Input,
+		InputLatency,
+		NewFrame,
+		DrawEvents,
+		Render,
+		Transfer,
+		Conversion,
+		Paint,
+
+		Num
+	};
+
+	enum class ECounter : uint8
+	{
+		DrawLists,
+		DrawCommands,
+		Vertices,
+		Indices,
+		BytesConverted,
+		CulledDrawCommands,
+		Allocations,
+		InputEvents,
+		CoalescedInputEvents,
+
+		Num
+	};
+
+	// Get the name of a timer, used in logs and dumps.
+	static const TCHAR* GetName(ETimer Timer);
+
+	// Get the name of a counter, used in logs and dumps.
+	static const TCHAR* GetName(ECounter Counter);
+
+	// Get the time in seconds measured by a timer in the last frame.
+	double GetTime(ETimer Timer) const { return Timers[static_cast<int32>(Timer)].Value; }
+
+	// Get the value of a counter in the last frame.
+	int64 GetCount(ECounter Counter) const { return Counters[static_cast<int32>(Counter)].Value; }
+
+	// Add time to a timer.
+	void AddTime(ETimer Timer, double Seconds) { Add(Timers[static_cast<int32>(Timer)], Seconds); }
+
+	// Add value to a counter.
+	void AddCount(ECounter Counter, int64 Value) { Add(Counters[static_cast<int32>(Counter)], Value); }
+
+private:
+
+	template<typename T>
+	struct TValue
+	{
+		T Value = 0;
+		uint32 FrameNumber = 0;
+	};
+
+	template<typename T>
+	static void Add(TValue<T>& Entry, T Value)
+	{
+		if (Entry.FrameNumber != GFrameNumber)
+		{
+			Entry.FrameNumber = GFrameNumber;
+			Entry.Value = 0;
+		}
+
+		Entry.Value += Value;
+	}
+
+	TValue<double> Timers[static_cast<int32>(ETimer::Num)];
+	TValue<int64> Counters[static_cast<int32>(ECounter::Num)];
+};
+
+// Measures time spent in a scope and adds it to a context timer.
+class FImGuiContextStatsScope
+{
+public:
+
+	FImGuiContextStatsScope(FImGuiContextStats& InStats, FImGuiContextStats::ETimer InTimer)
+		: Stats(InStats)
+		, Timer(InTimer)
+		, StartTime(FPlatformTime::Seconds())
+	{
+	}
+
+	~FImGuiContextStatsScope()
+	{
+		Stats.AddTime(Timer, FPlatformTime::Seconds() - StartTime);
+	}
+
+	FImGuiContextStatsScope(const FImGuiContextStatsScope&) = delete;
+	FImGuiContextStatsScope& operator=(const FImGuiContextStatsScope&) = delete;
+
+private:
+
+	FImGuiContextStats& Stats;
+	FImGuiContextStats::ETimer Timer;
+	double StartTime;
+};
@@ -4,6 +4,7 @@
 
 #include "ImGuiDemo.h"
 
+#include "ImGuiModule.h"
 #include "ImGuiModuleProperties.h"
 
 
@@ -26,6 +27,7 @@ void FImGuiDemo::DrawControls(int32 ContextIndex)
 			{
 				if (ImGui::Button("Demo Window")) ShowDemoWindowMask ^= ContextBit;
 				if (ImGui::Button("Another Window")) ShowAnotherWindowMask ^= ContextBit;
+				if (ImGui::Button("Texture Atlas")) ShowTextureAtlasWindowMask ^= ContextBit;
 			}
 			ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
 		}
@@ -39,6 +41,12 @@ void FImGuiDemo::DrawControls(int32 ContextIndex)
 			ImGui::End();
 		}
 
+		// Show icons drawn with and without the texture atlas.
+		if (ShowTextureAtlasWindowMask & ContextBit)
+		{
+			DrawTextureAtlasWindow();
+		}
+
 		// 3. Show the ImGui test window. Most of the sample code is in ImGui::ShowTestWindow()
 		if (ShowDemoWindowMask & ContextBit)
 		{
@@ -81,3 +89,98 @@ void FImGuiDemo::DrawControls(int32 ContextIndex)
 		}
 	}
 }
+
+void FImGuiDemo::DrawTextureAtlasWindow()
+{
+	constexpr int32 NumIcons = 64;
+	constexpr int32 IconSize = 16;
+	constexpr int32 IconsPerRow = 16;
+
+	if (AtlasIcons.Num() == 0)
+	{
+		TArray<FColor> Pixels;
+		Pixels.SetNumUninitialized(IconSize * IconSize);
+
+		for (int32 Icon = 0; Icon < NumIcons; Icon++)
+		{
+			// Circle with a different hue in every icon.
+			const FColor Color = FLinearColor::MakeFromHSV8(static_cast<uint8>(Icon * 256 / NumIcons), 200, 255).ToFColor(true);
+			for (int32 Y = 0; Y < IconSize; Y++)
+			{
+				for (int32 X = 0; X < IconSize; X++)
+				{
+					const float DistanceSquared = FMath::Square(X - IconSize * 0.5f + 0.5f) + FMath::Square(Y - IconSize * 0.5f + 0.5f);
+					Pixels[Y * IconSize + X] = DistanceSquared < FMath::Square(IconSize * 0.5f) ? Color : FColor::Transparent;
+				}
+			}
+
+			AtlasIcons.Add(FImGuiModule::Get().RegisterTexture(*FString::Printf(TEXT("ImGuiDemo_AtlasIcon_%d"), Icon),
+				IconSize, IconSize, Pixels.GetData(), false, true));
+			SeparateIcons.Add(FImGuiModule::Get().RegisterTexture(*FString::Printf(TEXT("ImGuiDemo_Icon_%d"), Icon),
+				IconSize, IconSize, Pixels.GetData(), false, false));
+		}
+	}
+
+	// Texture with a scrolling signal, in which every frame updates only one column.
+	constexpr int32 LiveWidth = 128;
+	constexpr int32 LiveHeight = 48;
+
+	if (LiveTexture.IsNull())
+	{
+		LivePixels.Init(FColor::Black, LiveWidth * LiveHeight);
+		LiveTexture = FImGuiModule::Get().RegisterTexture(TEXT("ImGuiDemo_LiveTexture"), LiveWidth, LiveHeight, LivePixels.GetData(), false, false);
+	}
+
+	if (LastLiveTextureFrameNumber != GFrameNumber)
+	{
+		LastLiveTextureFrameNumber = GFrameNumber;
+
+		const int32 Value = FMath::Clamp(FMath::RoundToInt((FMath::Sin(GFrameNumber * 0.1f) * 0.4f + 0.5f) * LiveHeight), 0, LiveHeight - 1);
+		for (int32 Y = 0; Y < LiveHeight; Y++)
+		{
+			LivePixels[Y * LiveWidth + LiveColumn] = (LiveHeight - 1 - Y) == Value ? FColor::Green : FColor::Black;
+		}
+
+		const FIntRect DirtyRect{ LiveColumn, 0, LiveColumn + 1, LiveHeight };
+		FImGuiModule::Get().UpdateTexture(LiveTexture, MakeArrayView(&DirtyRect, 1), LivePixels.GetData(), LiveWidth);
+
+		LiveColumn = (LiveColumn + 1) % LiveWidth;
+	}
+
+	// Draws icons and returns the number of draw commands that they added.
+	auto DrawIcons = [&](const TArray<FImGuiTextureHandle>& Icons)
+	{
+		const ImDrawList* DrawList = ImGui::GetWindowDrawList();
+		const int32 NumCommandsBefore = DrawList->CmdBuffer.Size;
+
+		for (int32 Icon = 0; Icon < Icons.Num(); Icon++)
+		{
+			const FImGuiTextureHandle& Handle = Icons[Icon];
+			ImGui::Image(Handle, ImVec2(IconSize, IconSize), Handle.GetUV0(), Handle.GetUV1());
+			if ((Icon + 1) % IconsPerRow != 0)
+			{
+				ImGui::SameLine();
+			}
+		}
+
+		return DrawList->CmdBuffer.Size - NumCommandsBefore;
+	};
+
+	ImGui::SetNextWindowSize(ImVec2(400, 460), ImGuiCond_FirstUseEver);
+	ImGui::Begin("Texture Atlas", nullptr);
+
+	ImGui::Text("Icons in the texture atlas:");
+	const int32 AtlasCommands = DrawIcons(AtlasIcons);
+
+	ImGui::Text("Icons in separate textures:");
+	const int32 SeparateCommands = DrawIcons(SeparateIcons);
+
+	ImGui::Separator();
+	ImGui::Text("Draw commands: %d with atlas, %d without atlas", AtlasCommands, SeparateCommands);
+
+	ImGui::Separator();
+	ImGui::Text("Texture updated one column per frame:");
+	ImGui::Image(LiveTexture, ImVec2(LiveWidth * 2, LiveHeight * 2));
+
+	ImGui::End();
+}
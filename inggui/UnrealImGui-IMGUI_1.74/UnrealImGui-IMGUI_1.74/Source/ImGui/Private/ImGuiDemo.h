@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "ImGuiTextureHandle.h"
+
 #include <imgui.h>
 
 class FImGuiModuleProperties;
@@ -20,12 +22,25 @@ public:
 
 private:
 
+	void DrawTextureAtlasWindow();
+
 	FImGuiModuleProperties& Properties;
 
 	ImVec4 ClearColor = ImColor{ 114, 144, 154 };
 
 	int32 ShowDemoWindowMask = 0;
 	int32 ShowAnotherWindowMask = 0;
+	int32 ShowTextureAtlasWindowMask = 0;
+
+	// The same icons registered with and without the texture atlas.
+	TArray<FImGuiTextureHandle> AtlasIcons;
+	TArray<FImGuiTextureHandle> SeparateIcons;
+
+	// Texture updated one column per frame.
+	FImGuiTextureHandle LiveTexture;
+	TArray<FColor> LivePixels;
+	int32 LiveColumn = 0;
+	uint32 LastLiveTextureFrameNumber = 0;
 
 	int32 DemoWindowCounter = 0;
 	uint32 LastDemoWindowFrameNumber = 0;
@@ -4,62 +4,615 @@
 
 #include "ImGuiDrawData.h"
 
+#include "ImGuiImplementation.h"
 
+#include <Hash/CityHash.h>
+#include <Math/VectorRegister.h>
+
+
+#if IMGUI_MODULE_DEVELOPER
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiDrawData, Log, All);
+#endif // IMGUI_MODULE_DEVELOPER
+
+namespace
+{
+	// Number of vertices converted in one iteration of the vectorized loop (two 4-wide registers per component).
+	constexpr int32 VERTEX_BATCH_SIZE = 8;
+
+	// Whether packed ImGui colours can be converted to FColor by swapping red and blue bytes. This is true for the
+	// default ImGui configuration, other configurations fall back to per-component unpacking.
+	constexpr bool bCanSwizzleColors = IM_COL32_R_SHIFT == 0 && IM_COL32_G_SHIFT == 8 && IM_COL32_B_SHIFT == 16
+		&& IM_COL32_A_SHIFT == 24 && PLATFORM_LITTLE_ENDIAN;
+
+	// Components of the ImGui to Slate transform, unpacked for conversion loops.
+	struct FVertexTransform
+	{
+		FVertexTransform(const FSlateRenderTransform& Transform)
+		{
+			Transform.GetMatrix().GetMatrix(A, B, C, D);
+			Tx = Transform.GetTranslation().X;
+			Ty = Transform.GetTranslation().Y;
+		}
+
+		float A, B, C, D, Tx, Ty;
+	};
+
+	FORCEINLINE void SetPosition(FSlateVertex& SlateVertex, float X, float Y)
+	{
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect) const
+		SlateVertex.Position[0] = X;
+		SlateVertex.Position[1] = Y;
 #else
-void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform) const
+		SlateVertex.Position.X = X;
+		SlateVertex.Position.Y = Y;
 #endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-{
-	// Reset and reserve space in destination buffer.
-	OutVertexBuffer.SetNumUninitialized(ImGuiVertexBuffer.Size, false);
+	}
 
-	// Transform and copy vertex data.
-	for (int Idx = 0; Idx < ImGuiVertexBuffer.Size; Idx++)
+	FORCEINLINE void SetTexCoords(FSlateVertex& SlateVertex, const ImDrawVert& ImGuiVertex)
 	{
-		const ImDrawVert& ImGuiVertex = ImGuiVertexBuffer[Idx];
-		FSlateVertex& SlateVertex = OutVertexBuffer[Idx];
-
 		// Final UV is calculated in shader as XY * ZW, so we need set all components.
 		SlateVertex.TexCoords[0] = ImGuiVertex.uv.x;
 		SlateVertex.TexCoords[1] = ImGuiVertex.uv.y;
 		SlateVertex.TexCoords[2] = SlateVertex.TexCoords[3] = 1.f;
+	}
+
+	// Reference conversion, one vertex at a time, with the same operation order as the vectorized path. Compilers may
+	// still contract the products and sums to fused multiply-adds (e.g. with -ffp-contract=fast) and explicit vector
+	// intrinsics are not contracted, so positions from both paths can differ in the last bits. Nothing relies on them
+	// being identical, the benchmark compares positions with a relative tolerance.
+	void ConvertVerticesScalar(const ImDrawVert* RESTRICT Src, FSlateVertex* RESTRICT Dst, int32 Num, const FVertexTransform& Transform)
+	{
+		for (int32 Idx = 0; Idx < Num; Idx++)
+		{
+			const ImDrawVert& ImGuiVertex = Src[Idx];
+			FSlateVertex& SlateVertex = Dst[Idx];
+
+			SetTexCoords(SlateVertex, ImGuiVertex);
+
+			const float XA = ImGuiVertex.pos.x * Transform.A;
+			const float YC = ImGuiVertex.pos.y * Transform.C;
+			const float XB = ImGuiVertex.pos.x * Transform.B;
+			const float YD = ImGuiVertex.pos.y * Transform.D;
+			const float X = XA + YC;
+			const float Y = XB + YD;
+			SetPosition(SlateVertex, X + Transform.Tx, Y + Transform.Ty);
+
+			// Unpack ImU32 color.
+			SlateVertex.Color = ImGuiInterops::UnpackImU32Color(ImGuiVertex.col);
+		}
+	}
+
+	// Batch conversion processing VERTEX_BATCH_SIZE vertices per iteration using engine vector registers, which map
+	// to SSE or AVX on x64 and to NEON on ARM. Remaining vertices are converted with the scalar path.
+	void ConvertVerticesVectorized(const ImDrawVert* RESTRICT Src, FSlateVertex* RESTRICT Dst, int32 Num, const FVertexTransform& Transform)
+	{
+		const VectorRegister4Float A = VectorSetFloat1(Transform.A);
+		const VectorRegister4Float B = VectorSetFloat1(Transform.B);
+		const VectorRegister4Float C = VectorSetFloat1(Transform.C);
+		const VectorRegister4Float D = VectorSetFloat1(Transform.D);
+		const VectorRegister4Float Tx = VectorSetFloat1(Transform.Tx);
+		const VectorRegister4Float Ty = VectorSetFloat1(Transform.Ty);
+
+		const VectorRegister4Int GreenAlphaMask = VectorIntSet1(static_cast<int32>(0xFF00FF00));
+		const VectorRegister4Int LowByteMask = VectorIntSet1(0xFF);
+
+		alignas(16) float OutX[VERTEX_BATCH_SIZE];
+		alignas(16) float OutY[VERTEX_BATCH_SIZE];
+		alignas(16) uint32 OutColors[VERTEX_BATCH_SIZE];
+
+		const int32 NumBatched = Num - Num % VERTEX_BATCH_SIZE;
+		for (int32 BatchStart = 0; BatchStart < NumBatched; BatchStart += VERTEX_BATCH_SIZE)
+		{
+			const ImDrawVert* RESTRICT Batch = Src + BatchStart;
+
+			for (int32 Half = 0; Half < VERTEX_BATCH_SIZE; Half += 4)
+			{
+				const ImDrawVert* RESTRICT V = Batch + Half;
+
+				const VectorRegister4Float X = MakeVectorRegisterFloat(V[0].pos.x, V[1].pos.x, V[2].pos.x, V[3].pos.x);
+				const VectorRegister4Float Y = MakeVectorRegisterFloat(V[0].pos.y, V[1].pos.y, V[2].pos.y, V[3].pos.y);
+
+				// Same operation order as in the scalar path: (X * A + Y * C) + Tx.
+				VectorStoreAligned(VectorAdd(VectorAdd(VectorMultiply(X, A), VectorMultiply(Y, C)), Tx), &OutX[Half]);
+				VectorStoreAligned(VectorAdd(VectorAdd(VectorMultiply(X, B), VectorMultiply(Y, D)), Ty), &OutY[Half]);
+
+				if (bCanSwizzleColors)
+				{
+					// ImGui stores colours as RGBA bytes and FColor as BGRA, so we only need to swap red and blue.
+					const VectorRegister4Int Colors = MakeVectorRegisterInt(static_cast<int32>(V[0].col), static_cast<int32>(V[1].col),
+						static_cast<int32>(V[2].col), static_cast<int32>(V[3].col));
+					const VectorRegister4Int Red = VectorShiftLeftImm(VectorIntAnd(Colors, LowByteMask), 16);
+					const VectorRegister4Int Blue = VectorIntAnd(VectorShiftRightImmLogical(Colors, 16), LowByteMask);
+					VectorIntStoreAligned(VectorIntOr(VectorIntAnd(Colors, GreenAlphaMask), VectorIntOr(Red, Blue)), &OutColors[Half]);
+				}
+			}
+
+			FSlateVertex* RESTRICT Out = Dst + BatchStart;
+			for (int32 Idx = 0; Idx < VERTEX_BATCH_SIZE; Idx++)
+			{
+				SetTexCoords(Out[Idx], Batch[Idx]);
+				SetPosition(Out[Idx], OutX[Idx], OutY[Idx]);
+
+				if (bCanSwizzleColors)
+				{
+					Out[Idx].Color.DWColor() = OutColors[Idx];
+				}
+				else
+				{
+					Out[Idx].Color = ImGuiInterops::UnpackImU32Color(Batch[Idx].col);
+				}
+			}
+		}
+
+		ConvertVerticesScalar(Src + NumBatched, Dst + NumBatched, Num - NumBatched, Transform);
+	}
+
+	// Element-wise index copy, used when index types differ and there is no specialised path for them.
+	// Indices are rebased by subtracting BaseVertex, so they can address a vertex sub-range.
+	template<typename SrcIndexType, typename DstIndexType>
+	struct TIndexCopy
+	{
+		static void Copy(const SrcIndexType* RESTRICT Src, DstIndexType* RESTRICT Dst, int32 Num, uint32 BaseVertex)
+		{
+			for (int32 Idx = 0; Idx < Num; Idx++)
+			{
+				Dst[Idx] = static_cast<DstIndexType>(Src[Idx] - BaseVertex);
+			}
+		}
+	};
+
+	// Indices of the same size can be copied in bulk, if they don't need to be rebased.
+	template<typename IndexType>
+	struct TIndexCopy<IndexType, IndexType>
+	{
+		static void Copy(const IndexType* RESTRICT Src, IndexType* RESTRICT Dst, int32 Num, uint32 BaseVertex)
+		{
+			if (BaseVertex == 0)
+			{
+				FMemory::Memcpy(Dst, Src, Num * sizeof(IndexType));
+			}
+			else
+			{
+				for (int32 Idx = 0; Idx < Num; Idx++)
+				{
+					Dst[Idx] = static_cast<IndexType>(Src[Idx] - BaseVertex);
+				}
+			}
+		}
+	};
+
+	// Widening of 16-bit ImGui indices to 32-bit Slate indices, eight indices per iteration.
+	template<>
+	struct TIndexCopy<uint16, uint32>
+	{
+		static void Copy(const uint16* RESTRICT Src, uint32* RESTRICT Dst, int32 Num, uint32 BaseVertex)
+		{
+			int32 Idx = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+			const uint32x4_t Base = vdupq_n_u32(BaseVertex);
+			for (; Idx + 8 <= Num; Idx += 8)
+			{
+				const uint16x8_t Packed = vld1q_u16(Src + Idx);
+				vst1q_u32(Dst + Idx, vsubq_u32(vmovl_u16(vget_low_u16(Packed)), Base));
+				vst1q_u32(Dst + Idx + 4, vsubq_u32(vmovl_u16(vget_high_u16(Packed)), Base));
+			}
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+			const __m128i Zero = _mm_setzero_si128();
+			const __m128i Base = _mm_set1_epi32(static_cast<int32>(BaseVertex));
+			for (; Idx + 8 <= Num; Idx += 8)
+			{
+				const __m128i Packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + Idx));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + Idx), _mm_sub_epi32(_mm_unpacklo_epi16(Packed, Zero), Base));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + Idx + 4), _mm_sub_epi32(_mm_unpackhi_epi16(Packed, Zero), Base));
+			}
+#endif // PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+
+			for (; Idx < Num; Idx++)
+			{
+				Dst[Idx] = Src[Idx] - BaseVertex;
+			}
+		}
+	};
+
+	FORCEINLINE void CopyIndices(const ImDrawIdx* RESTRICT Src, SlateIndex* RESTRICT Dst, int32 Num, uint32 BaseVertex)
+	{
+		TIndexCopy<ImDrawIdx, SlateIndex>::Copy(Src, Dst, Num, BaseVertex);
+	}
+
+	// Counts growths of draw data buffers, so we can verify that steady-state frames don't allocate.
+	FThreadSafeCounter NumBufferGrowths;
+
+	template<typename T>
+	FORCEINLINE void CountBufferGrowth(const TArray<T>& Buffer, int32 NumElements)
+	{
+		if (NumElements > Buffer.Max())
+		{
+			NumBufferGrowths.Increment();
+		}
+	}
+
+	// Copy ImGui vector content. Destination capacity is never reduced.
+	template<typename T>
+	FORCEINLINE void CopyBuffer(ImVector<T>& Dst, const ImVector<T>& Src)
+	{
+		if (Src.Size > Dst.Capacity)
+		{
+			NumBufferGrowths.Increment();
+		}
+
+		Dst.resize(Src.Size);
+		if (Src.Size > 0)
+		{
+			FMemory::Memcpy(Dst.Data, Src.Data, Src.size_in_bytes());
+		}
+	}
+
+	FORCEINLINE bool AreClipRectsEqual(const ImVec4& Lhs, const ImVec4& Rhs)
+	{
+		return Lhs.x == Rhs.x && Lhs.y == Rhs.y && Lhs.z == Rhs.z && Lhs.w == Rhs.w;
+	}
+}
+
+int32 FImGuiDrawList::GetBatches(TArray<FImGuiDrawBatch>& OutBatches, const FSlateRenderTransform& Transform, const FSlateRect* CullingRect) const
+{
+	OutBatches.Reset();
+
+	// Merge consecutive commands using the same texture and clipping rectangle. Their index ranges are adjacent, so
+	// a merged batch is still described by a single index range. Commands that share clipping rectangle with a culled
+	// command are culled without transforming the rectangle again.
+	const ImDrawCmd* BatchCommand = nullptr;
+	bool bIsBatchCulled = false;
+	int32 NumCulled = 0;
+	int32 IndexOffset = 0;
+	for (const ImDrawCmd& Command : ImGuiCommandBuffer)
+	{
+		const int32 NumElements = static_cast<int32>(Command.ElemCount);
+		if (NumElements > 0)
+		{
+			const bool bHasBatchClipRect = BatchCommand && AreClipRectsEqual(BatchCommand->ClipRect, Command.ClipRect);
+			if (bHasBatchClipRect && bIsBatchCulled)
+			{
+				NumCulled++;
+			}
+			else if (bHasBatchClipRect && BatchCommand->TextureId == Command.TextureId)
+			{
+				OutBatches.Last().NumIndices += NumElements;
+			}
+			else
+			{
+				BatchCommand = &Command;
+
+				const FSlateRect ClippingRect = TransformRect(Transform, ImGuiInterops::ToSlateRect(Command.ClipRect));
+				bIsBatchCulled = CullingRect && !FSlateRect::DoRectanglesIntersect(ClippingRect, *CullingRect);
+				if (bIsBatchCulled)
+				{
+					NumCulled++;
+				}
+				else
+				{
+					FImGuiDrawBatch& Batch = OutBatches.AddDefaulted_GetRef();
+					Batch.ClippingRect = ClippingRect;
+					Batch.TextureId = ImGuiInterops::ToTextureIndex(Command.TextureId);
+					Batch.IndexOffset = IndexOffset;
+					Batch.NumIndices = NumElements;
+				}
+			}
+		}
+
+		IndexOffset += NumElements;
+	}
+
+	// Find the range of vertices referenced by each batch, so we only need to convert and submit that range.
+	for (FImGuiDrawBatch& Batch : OutBatches)
+	{
+		const ImDrawIdx* Indices = ImGuiIndexBuffer.Data + Batch.IndexOffset;
+
+		ImDrawIdx MinIndex = Indices[0];
+		ImDrawIdx MaxIndex = Indices[0];
+		for (int32 Idx = 1; Idx < Batch.NumIndices; Idx++)
+		{
+			MinIndex = FMath::Min(MinIndex, Indices[Idx]);
+			MaxIndex = FMath::Max(MaxIndex, Indices[Idx]);
+		}
+
+		Batch.VertexOffset = MinIndex;
+		Batch.NumVertices = MaxIndex - MinIndex + 1;
+	}
+
+	return NumCulled;
+}
 
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-		const FVector2D VertexPosition = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
-		SlateVertex.Position[0] = VertexPosition.X;
-		SlateVertex.Position[1] = VertexPosition.Y;
-		SlateVertex.ClipRect = VertexClippingRect;
+void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FSlateRenderTransform& Transform, const int32 StartVertex, const int32 NumVertices, const FSlateRotatedRect& VertexClippingRect) const
 #else
-		SlateVertex.Position = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
+void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FSlateRenderTransform& Transform, const int32 StartVertex, const int32 NumVertices) const
 #endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+{
+	// Reset and reserve space in destination buffer.
+	OutVertexBuffer.SetNumUninitialized(NumVertices, false);
+
+	// Transform and copy vertex data.
+	ConvertVerticesVectorized(ImGuiVertexBuffer.Data + StartVertex, OutVertexBuffer.GetData(), NumVertices, FVertexTransform{ Transform });
 
-		// Unpack ImU32 color.
-		SlateVertex.Color = ImGuiInterops::UnpackImU32Color(ImGuiVertex.col);
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	for (FSlateVertex& SlateVertex : OutVertexBuffer)
+	{
+		SlateVertex.ClipRect = VertexClippingRect;
 	}
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 }
 
-void FImGuiDrawList::CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements) const
+void FImGuiDrawList::CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements, const int32 VertexOffset) const
 {
 	// Reset buffer.
 	OutIndexBuffer.SetNumUninitialized(NumElements, false);
 
-	// Copy elements (slow copy because of different sizes of ImDrawIdx and SlateIndex and because SlateIndex can
-	// have different size on different platforms).
-	for (int i = 0; i < NumElements; i++)
+	// Copy elements (SlateIndex can have different size than ImDrawIdx and it can differ between platforms).
+	CopyIndices(ImGuiIndexBuffer.Data + StartIndex, OutIndexBuffer.GetData(), NumElements, static_cast<uint32>(VertexOffset));
+}
+
+bool FImGuiDrawList::UpdateSignature(FImGuiDrawListSignature& Signature) const
+{
+	bool bHeadersMatch = Signature.NumVertices == ImGuiVertexBuffer.Size && Signature.NumIndices == ImGuiIndexBuffer.Size
+		&& Signature.Commands.Num() == ImGuiCommandBuffer.Size;
+
+	// Draw commands are compared by fields, because of the padding in ImDrawCmd. Headers are updated in the same
+	// pass, so the signature describes this list whatever the result.
+	Signature.Commands.SetNumUninitialized(ImGuiCommandBuffer.Size, false);
+	for (int32 Index = 0; Index < ImGuiCommandBuffer.Size; Index++)
+	{
+		const ImDrawCmd& Command = ImGuiCommandBuffer[Index];
+		FImGuiDrawListSignature::FCommandHeader& Header = Signature.Commands[Index];
+
+		if (bHeadersMatch)
+		{
+			bHeadersMatch = Header.ElemCount == Command.ElemCount && Header.TextureId == Command.TextureId
+				&& Header.ClipRect.x == Command.ClipRect.x && Header.ClipRect.y == Command.ClipRect.y
+				&& Header.ClipRect.z == Command.ClipRect.z && Header.ClipRect.w == Command.ClipRect.w;
+		}
+
+		Header.ClipRect = Command.ClipRect;
+		Header.TextureId = Command.TextureId;
+		Header.ElemCount = Command.ElemCount;
+	}
+
+	Signature.NumVertices = ImGuiVertexBuffer.Size;
+	Signature.NumIndices = ImGuiIndexBuffer.Size;
+
+	if (!bHeadersMatch)
 	{
-		OutIndexBuffer[i] = ImGuiIndexBuffer[StartIndex + i];
+		Signature.BufferHash.Reset();
+		return true;
 	}
+
+	const uint64 BufferHash = CalculateBufferHash();
+	const bool bChanged = !Signature.BufferHash.IsSet() || Signature.BufferHash.GetValue() != BufferHash;
+	Signature.BufferHash = BufferHash;
+	return bChanged;
 }
 
-void FImGuiDrawList::TransferDrawData(ImDrawList& Src)
+uint64 FImGuiDrawList::CalculateChecksum() const
 {
-	// Move data from source to this list.
-	Src.CmdBuffer.swap(ImGuiCommandBuffer);
-	Src.IdxBuffer.swap(ImGuiIndexBuffer);
-	Src.VtxBuffer.swap(ImGuiVertexBuffer);
-
-	// ImGui seems to clear draw lists in every frame, but since source list can contain pointers to buffers that
-	// we just swapped, it is better to clear explicitly here.
-	Src.Clear();
+	uint64 Checksum = CalculateBufferHash();
+
+	// Draw commands are hashed by fields, because of the padding in ImDrawCmd.
+	for (const ImDrawCmd& Command : ImGuiCommandBuffer)
+	{
+		Checksum = CityHash64WithSeed(reinterpret_cast<const char*>(&Command.ElemCount), sizeof(Command.ElemCount), Checksum);
+		Checksum = CityHash64WithSeed(reinterpret_cast<const char*>(&Command.ClipRect), sizeof(Command.ClipRect), Checksum);
+		Checksum = CityHash64WithSeed(reinterpret_cast<const char*>(&Command.TextureId), sizeof(Command.TextureId), Checksum);
+	}
+
+	return Checksum;
 }
+
+uint64 FImGuiDrawList::CalculateBufferHash() const
+{
+	const uint64 VertexHash = CityHash64(reinterpret_cast<const char*>(ImGuiVertexBuffer.Data), ImGuiVertexBuffer.size_in_bytes());
+	return CityHash64WithSeed(reinterpret_cast<const char*>(ImGuiIndexBuffer.Data), ImGuiIndexBuffer.size_in_bytes(), VertexHash);
+}
+
+void FImGuiDrawList::CopyDrawData(const ImDrawList& Src)
+{
+	CopyBuffer(ImGuiCommandBuffer, Src.CmdBuffer);
+	CopyBuffer(ImGuiIndexBuffer, Src.IdxBuffer);
+	CopyBuffer(ImGuiVertexBuffer, Src.VtxBuffer);
+}
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+void FImGuiSlateDrawData::Prepare(TArrayView<const FImGuiDrawList> DrawLists, const FSlateRenderTransform& InTransform, const FSlateRect& InCullingRect)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	Transform = InTransform;
+	CullingRect = InCullingRect;
+	NumBatches = 0;
+	NumBytesConverted = 0;
+	NumCulledCommands = 0;
+
+	for (const FImGuiDrawList& DrawList : DrawLists)
+	{
+		NumCulledCommands += DrawList.GetBatches(DrawBatches, Transform, &CullingRect);
+
+		for (const FImGuiDrawBatch& DrawBatch : DrawBatches)
+		{
+			// Grow without shrinking, so buffers of batches that are not used in this frame are not released.
+			if (NumBatches == Batches.Num())
+			{
+				CountBufferGrowth(Batches, NumBatches + 1);
+				Batches.AddDefaulted();
+			}
+
+			FImGuiSlateBatch& Batch = Batches[NumBatches++];
+			Batch.ClippingRect = DrawBatch.ClippingRect;
+			Batch.TextureId = DrawBatch.TextureId;
+
+			CountBufferGrowth(Batch.Vertices, DrawBatch.NumVertices);
+			CountBufferGrowth(Batch.Indices, DrawBatch.NumIndices);
+			DrawList.CopyVertexData(Batch.Vertices, Transform, DrawBatch.VertexOffset, DrawBatch.NumVertices);
+			DrawList.CopyIndexData(Batch.Indices, DrawBatch.IndexOffset, DrawBatch.NumIndices, DrawBatch.VertexOffset);
+
+			NumBytesConverted += DrawBatch.NumVertices * sizeof(FSlateVertex) + DrawBatch.NumIndices * sizeof(SlateIndex);
+		}
+	}
+
+	PrepareTime = FPlatformTime::Seconds() - StartTime;
+}
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+namespace ImGuiDrawDataCounters
+{
+	uint32 GetNumBufferGrowths()
+	{
+		return static_cast<uint32>(NumBufferGrowths.GetValue());
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// Developer benchmarks
+//----------------------------------------------------------------------------------------------------
+
+#if IMGUI_MODULE_DEVELOPER
+
+namespace
+{
+	// Relative tolerance for transformed positions, a few ulps to allow for contraction to fused multiply-adds.
+	constexpr float PositionTolerance = 1e-6f;
+
+	bool IsPositionNearlyEqual(float Lhs, float Rhs)
+	{
+		return FMath::Abs(Lhs - Rhs) <= PositionTolerance * FMath::Max(1.f, FMath::Abs(Lhs));
+	}
+
+	bool AreConvertedVerticesEqual(const FSlateVertex& Lhs, const FSlateVertex& Rhs)
+	{
+		// Compare only the components written by the conversion. Texture coordinates and colours are copied without
+		// arithmetic and must match exactly, positions are transformed and may differ by rounding.
+		return FMemory::Memcmp(Lhs.TexCoords, Rhs.TexCoords, sizeof(Lhs.TexCoords)) == 0
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+			&& IsPositionNearlyEqual(Lhs.Position[0], Rhs.Position[0])
+			&& IsPositionNearlyEqual(Lhs.Position[1], Rhs.Position[1])
+#else
+			&& IsPositionNearlyEqual(Lhs.Position.X, Rhs.Position.X)
+			&& IsPositionNearlyEqual(Lhs.Position.Y, Rhs.Position.Y)
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+			&& Lhs.Color == Rhs.Color;
+	}
+
+	void BenchmarkVertexConversion(const TArray<FString>& Args)
+	{
+		const int32 NumVertices = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 200000;
+		constexpr int32 NumIterations = 50;
+
+		// Pseudo-random vertices and a scaled and translated transform, like one set by the canvas control.
+		FRandomStream Random{ 0x1A6D };
+		TArray<ImDrawVert> Source;
+		Source.SetNumUninitialized(NumVertices);
+		for (ImDrawVert& Vertex : Source)
+		{
+			Vertex.pos = { Random.FRandRange(-100.f, 4000.f), Random.FRandRange(-100.f, 2200.f) };
+			Vertex.uv = { Random.FRand(), Random.FRand() };
+			Vertex.col = static_cast<ImU32>(Random.GetUnsignedInt());
+		}
+
+		const FSlateRenderTransform Transform{ 0.73f, FVector2D{ 17.25f, -3.5f } };
+		const FVertexTransform VertexTransform{ Transform };
+
+		TArray<FSlateVertex> ScalarOutput;
+		TArray<FSlateVertex> VectorizedOutput;
+		ScalarOutput.SetNumZeroed(NumVertices);
+		VectorizedOutput.SetNumZeroed(NumVertices);
+
+		double ScalarSeconds = 0.0;
+		double VectorizedSeconds = 0.0;
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			double StartTime = FPlatformTime::Seconds();
+			ConvertVerticesScalar(Source.GetData(), ScalarOutput.GetData(), NumVertices, VertexTransform);
+			ScalarSeconds += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			ConvertVerticesVectorized(Source.GetData(), VectorizedOutput.GetData(), NumVertices, VertexTransform);
+			VectorizedSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		int32 NumMismatches = 0;
+		for (int32 Idx = 0; Idx < NumVertices; Idx++)
+		{
+			if (!AreConvertedVerticesEqual(ScalarOutput[Idx], VectorizedOutput[Idx]))
+			{
+				NumMismatches++;
+			}
+		}
+
+		UE_LOG(LogImGuiDrawData, Display, TEXT("Vertex conversion of %d vertices (average of %d runs): scalar %.3f ms, vectorized %.3f ms (x%.2f)."),
+			NumVertices, NumIterations, ScalarSeconds * 1000.0 / NumIterations, VectorizedSeconds * 1000.0 / NumIterations,
+			VectorizedSeconds > 0.0 ? ScalarSeconds / VectorizedSeconds : 0.0);
+
+		if (NumMismatches > 0)
+		{
+			UE_LOG(LogImGuiDrawData, Error, TEXT("Vectorized vertex conversion differs from scalar conversion in %d of %d vertices."),
+				NumMismatches, NumVertices);
+		}
+		else
+		{
+			UE_LOG(LogImGuiDrawData, Display, TEXT("Vectorized vertex conversion matches scalar conversion."));
+		}
+	}
+
+	FAutoConsoleCommand BenchmarkVertexConversionCommand(TEXT("ImGui.Debug.BenchmarkVertexConversion"),
+		TEXT("Measure scalar and vectorized ImGui vertex conversion and verify that both give matching results.\n")
+		TEXT("Arguments: [NumVertices] (default 200000)"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkVertexConversion));
+
+	// Samples allocation counters once per frame and reports frames in which ImGui allocated or draw data buffers grew.
+	void CountFrameAllocations(const TArray<FString>& Args)
+	{
+		struct FState
+		{
+			int32 FramesLeft = 0;
+			int32 NumFrames = 0;
+			int32 NumAllocatingFrames = 0;
+			uint32 LastImGuiAllocations = 0;
+			uint32 LastBufferGrowths = 0;
+			FDelegateHandle TickHandle;
+		};
+
+		TSharedRef<FState> State = MakeShared<FState>();
+		State->NumFrames = State->FramesLeft = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 120;
+		State->LastImGuiAllocations = ImGuiImplementation::GetNumAllocations();
+		State->LastBufferGrowths = ImGuiDrawDataCounters::GetNumBufferGrowths();
+
+		State->TickHandle = FSlateApplication::Get().OnPostTick().AddLambda([State](float)
+		{
+			const uint32 ImGuiAllocations = ImGuiImplementation::GetNumAllocations();
+			const uint32 BufferGrowths = ImGuiDrawDataCounters::GetNumBufferGrowths();
+			if (ImGuiAllocations != State->LastImGuiAllocations || BufferGrowths != State->LastBufferGrowths)
+			{
+				State->NumAllocatingFrames++;
+				UE_LOG(LogImGuiDrawData, Display, TEXT("Frame %u: %u ImGui allocations, %u draw data buffer growths."),
+					GFrameNumber, ImGuiAllocations - State->LastImGuiAllocations, BufferGrowths - State->LastBufferGrowths);
+			}
+
+			State->LastImGuiAllocations = ImGuiAllocations;
+			State->LastBufferGrowths = BufferGrowths;
+
+			if (--State->FramesLeft == 0)
+			{
+				UE_LOG(LogImGuiDrawData, Display, TEXT("%d of %d frames allocated ImGui memory or grew draw data buffers."),
+					State->NumAllocatingFrames, State->NumFrames);
+				FSlateApplication::Get().OnPostTick().Remove(State->TickHandle);
+			}
+		});
+	}
+
+	FAutoConsoleCommand CountFrameAllocationsCommand(TEXT("ImGui.Debug.CountFrameAllocations"),
+		TEXT("Count ImGui allocations and draw data buffer growths over a number of frames. In steady state, with\n")
+		TEXT("unchanging window layout, no frame should allocate.\n")
+		TEXT("Arguments: [NumFrames] (default 120)"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&CountFrameAllocations));
+}
+
+#endif // IMGUI_MODULE_DEVELOPER
@@ -18,6 +18,41 @@ struct FImGuiDrawCommand
 	TextureIndex TextureId;
 };
 
+// Range of consecutive ImGui draw commands that share texture and clipping rectangle and can be drawn as one Slate
+// element.
+struct FImGuiDrawBatch
+{
+	FSlateRect ClippingRect;
+	TextureIndex TextureId;
+
+	// Range in the index buffer.
+	int32 IndexOffset;
+	int32 NumIndices;
+
+	// Range of vertices referenced by indices from this batch.
+	int32 VertexOffset;
+	int32 NumVertices;
+};
+
+// Summary of draw list content from the last frame, used to detect whether the content changed.
+struct FImGuiDrawListSignature
+{
+	// Fields of a draw command that affect rendering.
+	struct FCommandHeader
+	{
+		ImVec4 ClipRect;
+		ImTextureID TextureId;
+		uint32 ElemCount;
+	};
+
+	int32 NumVertices = -1;
+	int32 NumIndices = -1;
+	TArray<FCommandHeader> Commands;
+
+	// Hash of vertex and index buffers. Not set if the last update was resolved without hashing.
+	TOptional<uint64> BufferHash;
+};
+
 // Wraps raw ImGui draw list data in utilities that transform them for Slate.
 class FImGuiDrawList
 {
@@ -37,17 +72,41 @@ public:
 			ImGuiInterops::ToTextureIndex(ImGuiCommand.TextureId) };
 	}
 
+	// Get the number of vertices in this list.
+	FORCEINLINE int NumVertices() const { return ImGuiVertexBuffer.Size; }
+
+	// Get the number of indices in this list.
+	FORCEINLINE int NumIndices() const { return ImGuiIndexBuffer.Size; }
+
+	// Get vertices of this list in ImGui format.
+	TArrayView<const ImDrawVert> GetVertices() const { return { ImGuiVertexBuffer.Data, ImGuiVertexBuffer.Size }; }
+
+	// Get draw batches for this list (old data in the target array are replaced). Consecutive commands that share
+	// texture and clipping rectangle are merged into one batch. Commands with clipping rectangles outside of the
+	// culling rectangle are skipped, together with vertices that only they reference.
+	// @param OutBatches - Destination array
+	// @param Transform - Transform to apply to clipping rectangles
+	// @param CullingRect - If not null, rectangle in transformed space outside of which commands are not visible
+	// @returns The number of skipped commands
+	int32 GetBatches(TArray<FImGuiDrawBatch>& OutBatches, const FSlateRenderTransform& Transform, const FSlateRect* CullingRect = nullptr) const;
+
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-	// Transform and copy vertex data to target buffer (old data in the target buffer are replaced).
+	// Transform and copy a range of vertices to target buffer (old data in the target buffer are replaced). Vertices
+	// are converted in batches using vector instructions.
 	// @param OutVertexBuffer - Destination buffer
 	// @param Transform - Transform to apply to all vertices
+	// @param StartVertex - Index of the first vertex to copy
+	// @param NumVertices - How many vertices we want to copy
 	// @param VertexClippingRect - Clipping rectangle for transformed Slate vertices
-	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect) const;
+	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FSlateRenderTransform& Transform, const int32 StartVertex, const int32 NumVertices, const FSlateRotatedRect& VertexClippingRect) const;
 #else
-	// Transform and copy vertex data to target buffer (old data in the target buffer are replaced).
+	// Transform and copy a range of vertices to target buffer (old data in the target buffer are replaced). Vertices
+	// are converted in batches using vector instructions.
 	// @param OutVertexBuffer - Destination buffer
 	// @param Transform - Transform to apply to all vertices
-	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform) const;
+	// @param StartVertex - Index of the first vertex to copy
+	// @param NumVertices - How many vertices we want to copy
+	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FSlateRenderTransform& Transform, const int32 StartVertex, const int32 NumVertices) const;
 #endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 
 	// Transform and copy index data to target buffer (old data in the target buffer are replaced).
@@ -55,14 +114,77 @@ public:
 	// @param OutIndexBuffer - Destination buffer
 	// @param StartIndex - Start copying source data starting from this index
 	// @param NumElements - How many elements we want to copy
-	void CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements) const;
+	// @param VertexOffset - Value subtracted from copied indices, so they can address a range of copied vertices
+	void CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements, const int32 VertexOffset = 0) const;
+
+	// Compare the content of this list with a signature from the last frame and update the signature. Counts and
+	// draw command headers are compared first and only if they match, vertex and index buffers are hashed. If they
+	// do not match, hashing is skipped and the next frame is also reported as changed, because there is no hash to
+	// compare with.
+	// @param Signature - Signature from the last frame, updated to describe this list
+	// @returns True, if the content differs from the one described by the signature
+	bool UpdateSignature(FImGuiDrawListSignature& Signature) const;
 
-	// Transfers data from ImGui source list to this object. Leaves source cleared.
-	void TransferDrawData(ImDrawList& Src);
+	// Calculate a checksum of vertices, indices and draw commands in this list.
+	uint64 CalculateChecksum() const;
+
+	// Copy data from ImGui source list to this object. Buffers in this object only grow, and the source keeps its
+	// buffers, so neither side needs to allocate once the frame content stabilises.
+	void CopyDrawData(const ImDrawList& Src);
 
 private:
 
+	uint64 CalculateBufferHash() const;
+
 	ImVector<ImDrawCmd> ImGuiCommandBuffer;
 	ImVector<ImDrawIdx> ImGuiIndexBuffer;
 	ImVector<ImDrawVert> ImGuiVertexBuffer;
 };
+
+// Draw batch converted to Slate format, so it can be submitted without further processing.
+struct FImGuiSlateBatch
+{
+	FSlateRect ClippingRect;
+	TextureIndex TextureId;
+	TArray<FSlateVertex> Vertices;
+	TArray<SlateIndex> Indices;
+};
+
+// Draw data of a whole context converted to Slate format for a given transform. Batches are retained between
+// preparations, so their buffers can be reused.
+struct FImGuiSlateDrawData
+{
+	// Transform and culling rectangle used to prepare this data.
+	FSlateRenderTransform Transform;
+	FSlateRect CullingRect;
+
+	// Prepared batches. Only the first NumBatches are valid.
+	TArray<FImGuiSlateBatch> Batches;
+	int32 NumBatches = 0;
+
+	// Time in seconds spent in the last preparation, the number of bytes it produced and the number of draw commands
+	// it skipped as not visible.
+	double PrepareTime = 0.0;
+	int32 NumBytesConverted = 0;
+	int32 NumCulledCommands = 0;
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	// Convert draw lists to Slate format (old data are replaced). Safe to call outside of the game thread as long as
+	// draw lists are not modified in the meantime.
+	// @param DrawLists - Source draw lists
+	// @param InTransform - Transform to apply to vertices and clipping rectangles
+	// @param InCullingRect - Rectangle in transformed space, outside of which draw commands are not converted
+	void Prepare(TArrayView<const FImGuiDrawList> DrawLists, const FSlateRenderTransform& InTransform, const FSlateRect& InCullingRect);
+#endif // !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+private:
+
+	// Scratch buffer for batches of a single draw list.
+	TArray<FImGuiDrawBatch> DrawBatches;
+};
+
+namespace ImGuiDrawDataCounters
+{
+	// Get the number of times draw list or Slate draw data buffers had to grow. In steady state it should not change.
+	uint32 GetNumBufferGrowths();
+}
@@ -0,0 +1,482 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiDynamicFont.h"
+
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+
+// TrueType rasterizer and rectangle packer bundled with ImGui. ImGui compiles them with static linkage, so we need our
+// own implementations, unless in unity build they are already a part of the same compilation unit (together with their
+// declarations).
+#ifndef STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_malloc(x,u) ((void)(u), FMemory::Malloc(x))
+#define STBTT_free(x,u) ((void)(u), FMemory::Free(x))
+#define STBTT_assert(x) check(x)
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "imstb_truetype.h"
+#endif
+
+#ifndef STB_RECT_PACK_IMPLEMENTATION
+#define STBRP_STATIC
+#define STBRP_ASSERT(x) check(x)
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+#endif
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiDynamicFont, Log, All);
+
+namespace
+{
+	// Identifier of the custom atlas rectangle with placeholders (ImGui requires values from 0x110000).
+	constexpr unsigned int MarkerRectId = 0x110000;
+
+	// Transparent gutter around glyphs, so they don't bleed into each other when filtered.
+	constexpr int32 Padding = 1;
+}
+
+struct FImGuiDynamicFont::FFontInfo
+{
+	stbtt_fontinfo Info;
+};
+
+// Packs glyphs into rows added to the atlas in the last growth.
+struct FImGuiDynamicFont::FPacker
+{
+	stbrp_context Context;
+	TArray<stbrp_node> Nodes;
+	int32 RegionY = 0;
+};
+
+FImGuiDynamicFont::FImGuiDynamicFont() = default;
+FImGuiDynamicFont::~FImGuiDynamicFont() = default;
+
+void FImGuiDynamicFont::Reserve(ImFontAtlas& InAtlas)
+{
+	checkf(!InAtlas.IsBuilt(), TEXT("Placeholder area needs to be reserved before the font atlas is built."));
+
+	Atlas = &InAtlas;
+
+	// Placeholders sample the middle of 3x3 transparent texels, so filtering never reaches other glyphs.
+	MarkerRectIndex = Atlas->AddCustomRectRegular(MarkerRectId, 3, 3);
+}
+
+bool FImGuiDynamicFont::Initialize(const FString& FontFile)
+{
+	checkf(Atlas && Atlas->IsBuilt(), TEXT("Dynamic font needs a built font atlas."));
+	checkf(!IsInitialized(), TEXT("Dynamic font can be only initialized once."));
+
+	const FString FilePath = FPaths::IsRelative(FontFile) ? FPaths::Combine(FPaths::ProjectDir(), FontFile) : FontFile;
+	if (!FFileHelper::LoadFileToArray(FontData, *FilePath))
+	{
+		UE_LOG(LogImGuiDynamicFont, Warning, TEXT("Failed to load font file '%s'."), *FilePath);
+		return false;
+	}
+
+	FontInfo = MakeUnique<FFontInfo>();
+	if (!stbtt_InitFont(&FontInfo->Info, FontData.GetData(), stbtt_GetFontOffsetForIndex(FontData.GetData(), 0)))
+	{
+		UE_LOG(LogImGuiDynamicFont, Warning, TEXT("Failed to read font file '%s'."), *FilePath);
+		FontInfo.Reset();
+		FontData.Empty();
+		return false;
+	}
+
+	ImFont* DefaultFont = Atlas->Fonts[0];
+	Scale = stbtt_ScaleForPixelHeight(&FontInfo->Info, DefaultFont->FontSize);
+	UpdateMarkerBounds();
+
+	// Placeholders only need horizontal metrics, which are cheap to read compared to rasterization.
+	const int32 NumIndicesBefore = DefaultFont->IndexLookup.Size;
+	const int32 NumGlyphsBefore = DefaultFont->Glyphs.Size;
+	for (uint32 Codepoint = 0x20; Codepoint <= 0xFFFD && DefaultFont->Glyphs.Size < 0xFFFF; Codepoint++)
+	{
+		// Skip surrogates and the private use area.
+		if (Codepoint >= 0xD800 && Codepoint <= 0xF8FF)
+		{
+			continue;
+		}
+
+		if (DefaultFont->FindGlyphNoFallback(static_cast<ImWchar>(Codepoint)))
+		{
+			continue;
+		}
+
+		const int GlyphIndex = stbtt_FindGlyphIndex(&FontInfo->Info, Codepoint);
+		if (GlyphIndex == 0)
+		{
+			continue;
+		}
+
+		int Advance, LeftSideBearing;
+		stbtt_GetGlyphHMetrics(&FontInfo->Info, GlyphIndex, &Advance, &LeftSideBearing);
+
+		// Placeholder is not empty, because ImGui clipping divides by glyph size.
+		const ImVec2 UV = EncodeCodepoint(static_cast<ImWchar>(Codepoint));
+		ImFontGlyph Glyph;
+		Glyph.Codepoint = static_cast<ImWchar>(Codepoint);
+		Glyph.AdvanceX = FMath::RoundToFloat(Advance * Scale);
+		Glyph.X0 = Glyph.Y0 = 0.f;
+		Glyph.X1 = Glyph.Y1 = 1.f;
+		Glyph.U0 = Glyph.U1 = UV.x;
+		Glyph.V0 = Glyph.V1 = UV.y;
+
+		DefaultFont->GrowIndex(Codepoint + 1);
+		DefaultFont->IndexLookup[Codepoint] = static_cast<ImWchar>(DefaultFont->Glyphs.Size);
+		DefaultFont->IndexAdvanceX[Codepoint] = Glyph.AdvanceX;
+		DefaultFont->Glyphs.push_back(Glyph);
+	}
+
+	// Like in ImFont::BuildLookupTable, missing code points in the grown index use the fallback advance.
+	for (int32 Index = NumIndicesBefore; Index < DefaultFont->IndexAdvanceX.Size; Index++)
+	{
+		if (DefaultFont->IndexAdvanceX[Index] < 0.f)
+		{
+			DefaultFont->IndexAdvanceX[Index] = DefaultFont->FallbackAdvanceX;
+		}
+	}
+
+	// Glyphs could be reallocated.
+	DefaultFont->FallbackGlyph = DefaultFont->FindGlyphNoFallback(DefaultFont->FallbackChar);
+
+	Font = DefaultFont;
+	NumGlyphs = Font->Glyphs.Size - NumGlyphsBefore;
+	RequestedCodepoints.Init(false, 0x10000);
+
+	UE_LOG(LogImGuiDynamicFont, Log, TEXT("Loaded font '%s' with %d glyphs rasterized on demand."), *FilePath, NumGlyphs);
+
+	return true;
+}
+
+void FImGuiDynamicFont::CollectRequests(TArrayView<const FImGuiDrawList> DrawLists)
+{
+	if (!IsInitialized())
+	{
+		return;
+	}
+
+	const float MarkerWidth = MarkerUV1.x - MarkerUV0.x;
+	const float MarkerHeight = MarkerUV1.y - MarkerUV0.y;
+
+	for (const FImGuiDrawList& DrawList : DrawLists)
+	{
+		for (const ImDrawVert& Vertex : DrawList.GetVertices())
+		{
+			if (Vertex.uv.x >= MarkerUV0.x && Vertex.uv.x < MarkerUV1.x && Vertex.uv.y >= MarkerUV0.y && Vertex.uv.y < MarkerUV1.y)
+			{
+				// Decode the code point from the position within the middle texel (see EncodeCodepoint).
+				const int32 Low = FMath::Clamp(static_cast<int32>((Vertex.uv.x - MarkerUV0.x) / MarkerWidth * 256.f), 0, 255);
+				const int32 High = FMath::Clamp(static_cast<int32>((Vertex.uv.y - MarkerUV0.y) / MarkerHeight * 256.f), 0, 255);
+				Request(static_cast<ImWchar>((High << 8) | Low));
+			}
+		}
+	}
+}
+
+void FImGuiDynamicFont::Request(ImWchar Codepoint)
+{
+	if (IsInitialized() && !RequestedCodepoints[Codepoint])
+	{
+		RequestedCodepoints[Codepoint] = true;
+		Requests.Add(Codepoint);
+	}
+}
+
+bool FImGuiDynamicFont::RasterizeRequests(FIntRect& OutDirtyRect, bool& bOutResized)
+{
+	bOutResized = false;
+	bool bDirty = false;
+
+	for (const ImWchar Codepoint : Requests)
+	{
+		if (bAtlasFull)
+		{
+			break;
+		}
+
+		// Only placeholders can be rasterized.
+		const ImWchar Index = Codepoint < Font->IndexLookup.Size ? Font->IndexLookup[Codepoint] : static_cast<ImWchar>(-1);
+		if (Index == static_cast<ImWchar>(-1))
+		{
+			continue;
+		}
+
+		ImFontGlyph& Glyph = Font->Glyphs[Index];
+		if (Glyph.U0 < MarkerUV0.x || Glyph.U0 >= MarkerUV1.x || Glyph.V0 < MarkerUV0.y || Glyph.V0 >= MarkerUV1.y)
+		{
+			continue;
+		}
+
+		const int GlyphIndex = stbtt_FindGlyphIndex(&FontInfo->Info, Codepoint);
+		int X0, Y0, X1, Y1;
+		stbtt_GetGlyphBitmapBox(&FontInfo->Info, GlyphIndex, Scale, Scale, &X0, &Y0, &X1, &Y1);
+		const int32 Width = X1 - X0;
+		const int32 Height = Y1 - Y0;
+
+		if (Width <= 0 || Height <= 0)
+		{
+			// Glyph without pixels, like a space. It is moved to the corner of the placeholder area, which is also
+			// transparent, but no longer detected as a placeholder.
+			const ImFontAtlasCustomRect* MarkerRect = Atlas->GetCustomRectByIndex(MarkerRectIndex);
+			Glyph.U0 = Glyph.U1 = (MarkerRect->X + 0.5f) * Atlas->TexUvScale.x;
+			Glyph.V0 = Glyph.V1 = (MarkerRect->Y + 0.5f) * Atlas->TexUvScale.y;
+			NumRasterizedGlyphs++;
+			continue;
+		}
+
+		stbrp_rect Rect{};
+		Rect.w = Width + 2 * Padding;
+		Rect.h = Height + 2 * Padding;
+
+		while (!Packer || !stbrp_pack_rects(&Packer->Context, &Rect, 1))
+		{
+			if (!Grow())
+			{
+				UE_LOG(LogImGuiDynamicFont, Warning, TEXT("Font atlas reached the maximum height of %d pixels. New glyphs will not be visible."),
+					MaxAtlasHeight);
+				bAtlasFull = true;
+				break;
+			}
+
+			bOutResized = true;
+		}
+
+		if (bAtlasFull)
+		{
+			break;
+		}
+
+		const int32 AtlasX = Rect.x + Padding;
+		const int32 AtlasY = Packer->RegionY + Rect.y + Padding;
+
+		GlyphPixels.SetNumUninitialized(Width * Height, false);
+		stbtt_MakeGlyphBitmap(&FontInfo->Info, GlyphPixels.GetData(), Width, Height, Width, Scale, Scale, GlyphIndex);
+
+		// Like in the atlas build, RGBA data are white with alpha from the rasterized glyph.
+		for (int32 Row = 0; Row < Height; Row++)
+		{
+			const uint8* Src = &GlyphPixels[Row * Width];
+			const int32 DstOffset = (AtlasY + Row) * Atlas->TexWidth + AtlasX;
+
+			if (Atlas->TexPixelsAlpha8)
+			{
+				FMemory::Memcpy(&Atlas->TexPixelsAlpha8[DstOffset], Src, Width);
+			}
+
+			if (Atlas->TexPixelsRGBA32)
+			{
+				for (int32 Column = 0; Column < Width; Column++)
+				{
+					Atlas->TexPixelsRGBA32[DstOffset + Column] = IM_COL32(255, 255, 255, Src[Column]);
+				}
+			}
+		}
+
+		const float OffsetY = static_cast<float>(static_cast<int32>(Font->Ascent + 0.5f));
+		Glyph.X0 = static_cast<float>(X0);
+		Glyph.Y0 = Y0 + OffsetY;
+		Glyph.X1 = static_cast<float>(X1);
+		Glyph.Y1 = Y1 + OffsetY;
+		Glyph.U0 = AtlasX * Atlas->TexUvScale.x;
+		Glyph.V0 = AtlasY * Atlas->TexUvScale.y;
+		Glyph.U1 = (AtlasX + Width) * Atlas->TexUvScale.x;
+		Glyph.V1 = (AtlasY + Height) * Atlas->TexUvScale.y;
+
+		const FIntRect GlyphRect{ AtlasX, AtlasY, AtlasX + Width, AtlasY + Height };
+		if (bDirty)
+		{
+			OutDirtyRect.Union(GlyphRect);
+		}
+		else
+		{
+			OutDirtyRect = GlyphRect;
+			bDirty = true;
+		}
+
+		NumRasterizedGlyphs++;
+	}
+
+	Requests.Reset();
+
+	return bDirty || bOutResized;
+}
+
+bool FImGuiDynamicFont::Grow()
+{
+	const int32 Width = Atlas->TexWidth;
+	const int32 OldHeight = Atlas->TexHeight;
+	const int32 NewHeight = OldHeight * 2;
+
+	if (NewHeight > MaxAtlasHeight)
+	{
+		return false;
+	}
+
+	// Pixel buffers are owned by the atlas, so they need to use ImGui allocator.
+	if (Atlas->TexPixelsAlpha8)
+	{
+		unsigned char* Pixels = static_cast<unsigned char*>(IM_ALLOC(Width * NewHeight));
+		FMemory::Memcpy(Pixels, Atlas->TexPixelsAlpha8, Width * OldHeight);
+		FMemory::Memzero(Pixels + Width * OldHeight, Width * (NewHeight - OldHeight));
+		IM_FREE(Atlas->TexPixelsAlpha8);
+		Atlas->TexPixelsAlpha8 = Pixels;
+	}
+
+	if (Atlas->TexPixelsRGBA32)
+	{
+		unsigned int* Pixels = static_cast<unsigned int*>(IM_ALLOC(Width * NewHeight * 4));
+		FMemory::Memcpy(Pixels, Atlas->TexPixelsRGBA32, Width * OldHeight * 4);
+		for (int32 Index = Width * OldHeight; Index < Width * NewHeight; Index++)
+		{
+			Pixels[Index] = IM_COL32(255, 255, 255, 0);
+		}
+		IM_FREE(Atlas->TexPixelsRGBA32);
+		Atlas->TexPixelsRGBA32 = Pixels;
+	}
+
+	// Texture coordinates are normalized, so vertical coordinates of all glyphs need to be rescaled. Placeholders are
+	// rescaled together with the marker texel, so they still decode to the same code points.
+	const float VScale = static_cast<float>(OldHeight) / NewHeight;
+	for (ImFont* AtlasFont : Atlas->Fonts)
+	{
+		for (ImFontGlyph& Glyph : AtlasFont->Glyphs)
+		{
+			Glyph.V0 *= VScale;
+			Glyph.V1 *= VScale;
+		}
+	}
+
+	Atlas->TexUvWhitePixel.y *= VScale;
+	Atlas->TexHeight = NewHeight;
+	Atlas->TexUvScale.y = 1.f / NewHeight;
+	UpdateMarkerBounds();
+
+	// Added rows are a new packing region. Space left in the previous region is not used anymore.
+	if (!Packer)
+	{
+		Packer = MakeUnique<FPacker>();
+	}
+
+	Packer->Nodes.SetNumUninitialized(Width);
+	stbrp_init_target(&Packer->Context, Width, NewHeight - OldHeight, Packer->Nodes.GetData(), Packer->Nodes.Num());
+	Packer->RegionY = OldHeight;
+
+	return true;
+}
+
+void FImGuiDynamicFont::UpdateMarkerBounds()
+{
+	const ImFontAtlasCustomRect* MarkerRect = Atlas->GetCustomRectByIndex(MarkerRectIndex);
+	MarkerUV0 = { (MarkerRect->X + 1) * Atlas->TexUvScale.x, (MarkerRect->Y + 1) * Atlas->TexUvScale.y };
+	MarkerUV1 = { (MarkerRect->X + 2) * Atlas->TexUvScale.x, (MarkerRect->Y + 2) * Atlas->TexUvScale.y };
+}
+
+ImVec2 FImGuiDynamicFont::EncodeCodepoint(ImWchar Codepoint) const
+{
+	// Low and high bytes select one of 256 positions within the middle texel, horizontally and vertically. Positions
+	// are centered, so decoding tolerates rounding errors.
+	const float X = ((Codepoint & 0xFF) + 0.5f) / 256.f;
+	const float Y = ((Codepoint >> 8) + 0.5f) / 256.f;
+	return { MarkerUV0.x + X * (MarkerUV1.x - MarkerUV0.x), MarkerUV0.y + Y * (MarkerUV1.y - MarkerUV0.y) };
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// Developer benchmarks
+//----------------------------------------------------------------------------------------------------
+
+#if IMGUI_MODULE_DEVELOPER
+
+namespace
+{
+	// Compares baking the full CJK range of a font into an atlas with loading the same font as a dynamic font and
+	// rasterizing only a number of glyphs, which simulates glyphs used by a localized tool.
+	void BenchmarkDynamicFont(const TArray<FString>& Args)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogImGuiDynamicFont, Warning, TEXT("Missing font file argument."));
+			return;
+		}
+
+		const FString FontFile = FPaths::IsRelative(Args[0]) ? FPaths::Combine(FPaths::ProjectDir(), Args[0]) : Args[0];
+		const int32 NumUsedGlyphs = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 0) : 500;
+
+		TArray<uint8> FontFileData;
+		if (!FFileHelper::LoadFileToArray(FontFileData, *FontFile))
+		{
+			UE_LOG(LogImGuiDynamicFont, Warning, TEXT("Failed to load font file '%s'."), *FontFile);
+			return;
+		}
+
+		unsigned char* Pixels;
+		int Width, Height;
+
+		// Full build, like adding the font with ImGui glyph ranges.
+		double BakeTime;
+		int32 BakeTextureSize;
+		{
+			ImFontAtlas FontAtlas;
+			FontAtlas.AddFontDefault();
+
+			ImFontConfig Config;
+			Config.MergeMode = true;
+			Config.FontDataOwnedByAtlas = false;
+			FontAtlas.AddFontFromMemoryTTF(FontFileData.GetData(), FontFileData.Num(), 13.f, &Config,
+				FontAtlas.GetGlyphRangesChineseFull());
+
+			const double StartTime = FPlatformTime::Seconds();
+			FontAtlas.GetTexDataAsAlpha8(&Pixels, &Width, &Height);
+			BakeTime = FPlatformTime::Seconds() - StartTime;
+			BakeTextureSize = Width * Height * 4;
+		}
+
+		// Dynamic font with a number of glyphs from the CJK Unified Ideographs block.
+		double InitializeTime, RasterizeTime;
+		int32 DynamicTextureSize, NumPlaceholders, NumRasterized;
+		{
+			ImFontAtlas FontAtlas;
+			FImGuiDynamicFont DynamicFont;
+			DynamicFont.Reserve(FontAtlas);
+			FontAtlas.GetTexDataAsAlpha8(&Pixels, &Width, &Height);
+
+			double StartTime = FPlatformTime::Seconds();
+			if (!DynamicFont.Initialize(FontFile))
+			{
+				return;
+			}
+			InitializeTime = FPlatformTime::Seconds() - StartTime;
+
+			for (int32 Index = 0; Index < NumUsedGlyphs; Index++)
+			{
+				DynamicFont.Request(static_cast<ImWchar>(0x4E00 + Index));
+			}
+
+			FIntRect DirtyRect;
+			bool bResized;
+			StartTime = FPlatformTime::Seconds();
+			DynamicFont.RasterizeRequests(DirtyRect, bResized);
+			RasterizeTime = FPlatformTime::Seconds() - StartTime;
+
+			FontAtlas.GetTexDataAsAlpha8(&Pixels, &Width, &Height);
+			DynamicTextureSize = Width * Height * 4;
+			NumPlaceholders = DynamicFont.GetNumGlyphs();
+			NumRasterized = DynamicFont.GetNumRasterizedGlyphs();
+		}
+
+		UE_LOG(LogImGuiDynamicFont, Display, TEXT("Full CJK bake: %.2f ms, texture %d KB."),
+			BakeTime * 1000.0, BakeTextureSize / 1024);
+		UE_LOG(LogImGuiDynamicFont, Display, TEXT("Dynamic font: %d glyphs available, initialization %.2f ms, %d glyphs rasterized in %.2f ms, texture %d KB."),
+			NumPlaceholders, InitializeTime * 1000.0, NumRasterized, RasterizeTime * 1000.0, DynamicTextureSize / 1024);
+	}
+
+	FAutoConsoleCommand BenchmarkDynamicFontCommand(TEXT("ImGui.Debug.BenchmarkDynamicFont"),
+		TEXT("Compare baking all CJK glyphs of a font with rasterizing only used glyphs in a dynamic font.\n")
+		TEXT("Arguments: FontFile [NumUsedGlyphs] (default 500)"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkDynamicFont));
+}
+
+#endif // IMGUI_MODULE_DEVELOPER
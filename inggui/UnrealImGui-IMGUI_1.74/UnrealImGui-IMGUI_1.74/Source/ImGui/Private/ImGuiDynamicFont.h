@@ -0,0 +1,101 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "ImGuiDrawData.h"
+
+#include <Core.h>
+
+#include <imgui.h>
+
+
+// Extends the default font of an ImGui font atlas with glyphs from a TrueType font, which are rasterized on their first
+// use. It allows to display large character sets, like CJK, without baking them into the atlas up front.
+//
+// ImGui 1.74 has no callback for missing glyphs, so every glyph available in the font file gets a placeholder: an
+// invisible glyph with correct advance, whose texture coordinates point to a reserved transparent area of the atlas and
+// encode its code point. Placeholders found in draw lists are rasterized and packed into the atlas, which grows in
+// height when it runs out of space. Text with new glyphs is invisible for one frame, but its layout is already final.
+class FImGuiDynamicFont
+{
+public:
+
+	// Maximum height of the atlas texture. Glyphs that don't fit remain invisible.
+	static constexpr int32 MaxAtlasHeight = 4096;
+
+	FImGuiDynamicFont();
+	~FImGuiDynamicFont();
+
+	FImGuiDynamicFont(const FImGuiDynamicFont&) = delete;
+	FImGuiDynamicFont& operator=(const FImGuiDynamicFont&) = delete;
+
+	// Reserve the atlas area used by placeholders. Needs to be called before the atlas is built.
+	// @param InAtlas - The font atlas, which needs to outlive this object
+	void Reserve(ImFontAtlas& InAtlas);
+
+	// Load a font file and add placeholders for all its glyphs that are missing in the default font. Needs to be
+	// called after the atlas is built and outside of ImGui frames. Can be only called once.
+	// @param FontFile - Path to a TrueType font file
+	// @returns True, if the font was loaded and false otherwise
+	bool Initialize(const FString& FontFile);
+
+	// Whether a font was loaded.
+	bool IsInitialized() const { return Font != nullptr; }
+
+	// Find placeholders in draw lists and request rasterization of their glyphs.
+	// @param DrawLists - Draw lists to scan
+	void CollectRequests(TArrayView<const FImGuiDrawList> DrawLists);
+
+	// Request rasterization of a glyph, before it is used.
+	// @param Codepoint - The code point of the glyph, ignored if font doesn't have it
+	void Request(ImWchar Codepoint);
+
+	// Rasterize requested glyphs into the atlas. Needs to be called outside of ImGui frames. If the atlas grows, the
+	// whole texture needs to be recreated, otherwise only the dirty area needs to be uploaded.
+	// @param OutDirtyRect - Receives the area of the atlas with new glyphs
+	// @param bOutResized - Receives whether the atlas size changed
+	// @returns True, if the atlas changed and false otherwise
+	bool RasterizeRequests(FIntRect& OutDirtyRect, bool& bOutResized);
+
+	// Get the number of glyphs that have placeholders or were rasterized.
+	int32 GetNumGlyphs() const { return NumGlyphs; }
+
+	// Get the number of rasterized glyphs.
+	int32 GetNumRasterizedGlyphs() const { return NumRasterizedGlyphs; }
+
+	// Get the number of glyphs waiting for rasterization.
+	int32 GetNumPendingRequests() const { return Requests.Num(); }
+
+private:
+
+	struct FFontInfo;
+	struct FPacker;
+
+	bool Grow();
+	void UpdateMarkerBounds();
+	ImVec2 EncodeCodepoint(ImWchar Codepoint) const;
+
+	ImFontAtlas* Atlas = nullptr;
+	ImFont* Font = nullptr;
+
+	TArray<uint8> FontData;
+	TUniquePtr<FFontInfo> FontInfo;
+	TUniquePtr<FPacker> Packer;
+	float Scale = 1.f;
+
+	// Custom rectangle with placeholders and bounds of its middle texel in texture coordinates.
+	int MarkerRectIndex = -1;
+	ImVec2 MarkerUV0;
+	ImVec2 MarkerUV1;
+
+	// Code points with placeholders that were already requested.
+	TBitArray<> RequestedCodepoints;
+	TArray<ImWchar> Requests;
+
+	// Scratch buffer for rasterization.
+	TArray<uint8> GlyphPixels;
+
+	int32 NumGlyphs = 0;
+	int32 NumRasterizedGlyphs = 0;
+	bool bAtlasFull = false;
+};
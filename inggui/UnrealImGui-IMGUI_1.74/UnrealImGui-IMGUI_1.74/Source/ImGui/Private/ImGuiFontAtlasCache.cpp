@@ -0,0 +1,399 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiFontAtlasCache.h"
+
+#include "ImGuiImplementation.h"
+
+#include <Misc/Crc.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Serialization/MemoryReader.h>
+#include <Serialization/MemoryWriter.h>
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiFontAtlasCache, Log, All);
+
+namespace
+{
+	constexpr uint32 CacheMagic = 0x41464749; // 'IGFA'
+
+	// Needs to be incremented, whenever the file layout changes.
+	constexpr uint32 CacheVersion = 1;
+
+	template<typename T>
+	uint32 Hash(const T& Value, uint32 Crc)
+	{
+		return FCrc::MemCrc32(&Value, sizeof(T), Crc);
+	}
+
+	int32 FindFontIndex(const ImFontAtlas& Atlas, const ImFont* Font)
+	{
+		for (int32 Index = 0; Index < Atlas.Fonts.Size; Index++)
+		{
+			if (Atlas.Fonts[Index] == Font)
+			{
+				return Index;
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	// Output data of a font, read from a cache file before it is applied.
+	struct FCachedFont
+	{
+		int32 ConfigDataIndex;
+		int32 ConfigDataCount;
+		float FontSize;
+		float Ascent;
+		float Descent;
+		int32 MetricsTotalSurface;
+		uint16 EllipsisChar;
+		TArray<ImFontGlyph> Glyphs;
+	};
+}
+
+namespace ImGuiFontAtlasCache
+{
+	FString GetDefaultCacheFile()
+	{
+#if ENGINE_COMPATIBILITY_LEGACY_SAVED_DIR
+		const FString SavedDir = FPaths::GameSavedDir();
+#else
+		const FString SavedDir = FPaths::ProjectSavedDir();
+#endif
+		return FPaths::Combine(*SavedDir, TEXT("ImGui"), TEXT("FontAtlas.bin"));
+	}
+
+	uint32 CalculateKey(const ImFontAtlas& Atlas)
+	{
+		uint32 Crc = Hash(CacheVersion, 0);
+		Crc = Hash(IMGUI_VERSION_NUM, Crc);
+		Crc = Hash(sizeof(ImFontGlyph), Crc);
+		Crc = Hash(Atlas.Flags, Crc);
+		Crc = Hash(Atlas.TexDesiredWidth, Crc);
+		Crc = Hash(Atlas.TexGlyphPadding, Crc);
+
+		Crc = Hash(Atlas.Fonts.Size, Crc);
+		for (const ImFont* Font : Atlas.Fonts)
+		{
+			Crc = Hash(Font->FallbackChar, Crc);
+		}
+
+		for (const ImFontConfig& Config : Atlas.ConfigData)
+		{
+			Crc = FCrc::MemCrc32(Config.FontData, Config.FontDataSize, Crc);
+			Crc = Hash(Config.FontNo, Crc);
+			Crc = Hash(Config.SizePixels, Crc);
+			Crc = Hash(Config.OversampleH, Crc);
+			Crc = Hash(Config.OversampleV, Crc);
+			Crc = Hash(Config.PixelSnapH, Crc);
+			Crc = Hash(Config.GlyphExtraSpacing, Crc);
+			Crc = Hash(Config.GlyphOffset, Crc);
+			Crc = Hash(Config.GlyphMinAdvanceX, Crc);
+			Crc = Hash(Config.GlyphMaxAdvanceX, Crc);
+			Crc = Hash(Config.MergeMode, Crc);
+			Crc = Hash(Config.RasterizerFlags, Crc);
+			Crc = Hash(Config.RasterizerMultiply, Crc);
+			Crc = Hash(Config.EllipsisChar, Crc);
+			Crc = Hash(FindFontIndex(Atlas, Config.DstFont), Crc);
+
+			// Null ranges select the default ranges, which are hashed as well.
+			const ImWchar* Ranges = Config.GlyphRanges ? Config.GlyphRanges : const_cast<ImFontAtlas&>(Atlas).GetGlyphRangesDefault();
+			for (; *Ranges; Ranges++)
+			{
+				Crc = Hash(*Ranges, Crc);
+			}
+		}
+
+		for (const ImFontAtlasCustomRect& Rect : Atlas.CustomRects)
+		{
+			Crc = Hash(Rect.ID, Crc);
+			Crc = Hash(Rect.Width, Crc);
+			Crc = Hash(Rect.Height, Crc);
+			Crc = Hash(Rect.GlyphAdvanceX, Crc);
+			Crc = Hash(Rect.GlyphOffset, Crc);
+			Crc = Hash(FindFontIndex(Atlas, Rect.Font), Crc);
+		}
+
+		return Crc;
+	}
+
+	bool Load(ImFontAtlas& Atlas, const FString& CacheFile)
+	{
+		checkf(!Atlas.IsBuilt(), TEXT("Font atlas cache can be only loaded to an atlas that is not built."));
+
+		// Rectangles added during build need to be a part of the key and receive their cached positions.
+		ImGuiImplementation::RegisterDefaultCustomRects(Atlas);
+
+		TArray<uint8> Data;
+		if (!FFileHelper::LoadFileToArray(Data, *CacheFile, FILEREAD_Silent))
+		{
+			return false;
+		}
+
+		FMemoryReader Reader{ Data };
+
+		uint32 Magic = 0, Version = 0, Key = 0;
+		Reader << Magic << Version << Key;
+		if (Reader.IsError() || Magic != CacheMagic || Version != CacheVersion || Key != CalculateKey(Atlas))
+		{
+			return false;
+		}
+
+		// Everything is read and validated before the atlas is modified.
+		int32 TexWidth = 0, TexHeight = 0;
+		ImVec2 TexUvWhitePixel;
+		Reader << TexWidth << TexHeight << TexUvWhitePixel.x << TexUvWhitePixel.y;
+
+		int32 NumRects = 0;
+		Reader << NumRects;
+		if (Reader.IsError() || NumRects != Atlas.CustomRects.Size)
+		{
+			return false;
+		}
+
+		TArray<FIntPoint> RectPositions;
+		RectPositions.SetNum(NumRects);
+		for (FIntPoint& Position : RectPositions)
+		{
+			Reader << Position.X << Position.Y;
+		}
+
+		int32 NumFonts = 0;
+		Reader << NumFonts;
+		if (Reader.IsError() || NumFonts != Atlas.Fonts.Size)
+		{
+			return false;
+		}
+
+		TArray<FCachedFont> Fonts;
+		Fonts.SetNum(NumFonts);
+		for (FCachedFont& Font : Fonts)
+		{
+			int32 NumGlyphs = 0;
+			Reader << Font.ConfigDataIndex << Font.ConfigDataCount << Font.FontSize << Font.Ascent << Font.Descent
+				<< Font.MetricsTotalSurface << Font.EllipsisChar << NumGlyphs;
+
+			if (Reader.IsError() || !Atlas.ConfigData.Data || Font.ConfigDataIndex < 0 || Font.ConfigDataIndex >= Atlas.ConfigData.Size
+				|| NumGlyphs < 0 || NumGlyphs >= 0xFFFF || static_cast<int64>(NumGlyphs * sizeof(ImFontGlyph)) > Reader.TotalSize() - Reader.Tell())
+			{
+				return false;
+			}
+
+			Font.Glyphs.SetNumUninitialized(NumGlyphs);
+			Reader.Serialize(Font.Glyphs.GetData(), NumGlyphs * sizeof(ImFontGlyph));
+		}
+
+		const int64 NumPixels = static_cast<int64>(TexWidth) * TexHeight;
+		if (Reader.IsError() || TexWidth <= 0 || TexHeight <= 0 || NumPixels != Reader.TotalSize() - Reader.Tell())
+		{
+			return false;
+		}
+
+		// Like ImGui build, we only provide alpha data. RGBA data are converted from them when requested.
+		Atlas.TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(NumPixels));
+		Reader.Serialize(Atlas.TexPixelsAlpha8, NumPixels);
+
+		Atlas.TexWidth = TexWidth;
+		Atlas.TexHeight = TexHeight;
+		Atlas.TexUvScale = ImVec2(1.f / TexWidth, 1.f / TexHeight);
+		Atlas.TexUvWhitePixel = TexUvWhitePixel;
+
+		for (int32 Index = 0; Index < NumRects; Index++)
+		{
+			Atlas.CustomRects[Index].X = static_cast<unsigned short>(RectPositions[Index].X);
+			Atlas.CustomRects[Index].Y = static_cast<unsigned short>(RectPositions[Index].Y);
+		}
+
+		for (int32 Index = 0; Index < NumFonts; Index++)
+		{
+			const FCachedFont& CachedFont = Fonts[Index];
+			ImFont* Font = Atlas.Fonts[Index];
+
+			// Same state as after ImFontAtlasBuildSetupFont and ImFontAtlasBuildFinish.
+			Font->ClearOutputData();
+			Font->FontSize = CachedFont.FontSize;
+			Font->ConfigData = &Atlas.ConfigData[CachedFont.ConfigDataIndex];
+			Font->ConfigDataCount = static_cast<short>(CachedFont.ConfigDataCount);
+			Font->ContainerAtlas = &Atlas;
+			Font->Ascent = CachedFont.Ascent;
+			Font->Descent = CachedFont.Descent;
+			Font->MetricsTotalSurface = CachedFont.MetricsTotalSurface;
+			Font->EllipsisChar = static_cast<ImWchar>(CachedFont.EllipsisChar);
+
+			Font->Glyphs.resize(CachedFont.Glyphs.Num());
+			FMemory::Memcpy(Font->Glyphs.Data, CachedFont.Glyphs.GetData(), CachedFont.Glyphs.Num() * sizeof(ImFontGlyph));
+			Font->BuildLookupTable();
+		}
+
+		return true;
+	}
+
+	bool Save(const ImFontAtlas& Atlas, const FString& CacheFile)
+	{
+		checkf(Atlas.TexPixelsAlpha8, TEXT("Font atlas needs to be built with alpha data before it can be saved."));
+
+		TArray<uint8> Data;
+		FMemoryWriter Writer{ Data };
+
+		uint32 Magic = CacheMagic, Version = CacheVersion, Key = CalculateKey(Atlas);
+		Writer << Magic << Version << Key;
+
+		int32 TexWidth = Atlas.TexWidth, TexHeight = Atlas.TexHeight;
+		ImVec2 TexUvWhitePixel = Atlas.TexUvWhitePixel;
+		Writer << TexWidth << TexHeight << TexUvWhitePixel.x << TexUvWhitePixel.y;
+
+		int32 NumRects = Atlas.CustomRects.Size;
+		Writer << NumRects;
+		for (const ImFontAtlasCustomRect& Rect : Atlas.CustomRects)
+		{
+			int32 X = Rect.X, Y = Rect.Y;
+			Writer << X << Y;
+		}
+
+		int32 NumFonts = Atlas.Fonts.Size;
+		Writer << NumFonts;
+		for (const ImFont* Font : Atlas.Fonts)
+		{
+			int32 ConfigDataIndex = Atlas.ConfigData.index_from_ptr(Font->ConfigData);
+			int32 ConfigDataCount = Font->ConfigDataCount;
+			float FontSize = Font->FontSize, Ascent = Font->Ascent, Descent = Font->Descent;
+			int32 MetricsTotalSurface = Font->MetricsTotalSurface;
+			uint16 EllipsisChar = Font->EllipsisChar;
+			int32 NumGlyphs = Font->Glyphs.Size;
+
+			Writer << ConfigDataIndex << ConfigDataCount << FontSize << Ascent << Descent << MetricsTotalSurface
+				<< EllipsisChar << NumGlyphs;
+			Writer.Serialize(Font->Glyphs.Data, NumGlyphs * sizeof(ImFontGlyph));
+		}
+
+		Writer.Serialize(Atlas.TexPixelsAlpha8, static_cast<int64>(TexWidth) * TexHeight);
+
+		return FFileHelper::SaveArrayToFile(Data, *CacheFile);
+	}
+
+	void Build(ImFontAtlas& Atlas, const FString& CacheFile)
+	{
+		// ImGui adds the default font during build, but the key needs to know about it.
+		if (Atlas.ConfigData.empty())
+		{
+			Atlas.AddFontDefault();
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		if (Load(Atlas, CacheFile))
+		{
+			UE_LOG(LogImGuiFontAtlasCache, Log, TEXT("Font atlas loaded from '%s' in %.2f ms."), *CacheFile,
+				(FPlatformTime::Seconds() - StartTime) * 1000.0);
+			return;
+		}
+
+		unsigned char* Pixels;
+		int Width, Height;
+		Atlas.GetTexDataAsAlpha8(&Pixels, &Width, &Height);
+
+		const double BuildTime = FPlatformTime::Seconds() - StartTime;
+
+		if (Save(Atlas, CacheFile))
+		{
+			UE_LOG(LogImGuiFontAtlasCache, Log, TEXT("Font atlas built in %.2f ms and saved to '%s'."), BuildTime * 1000.0, *CacheFile);
+		}
+		else
+		{
+			UE_LOG(LogImGuiFontAtlasCache, Warning, TEXT("Font atlas built in %.2f ms, but it couldn't be saved to '%s'."),
+				BuildTime * 1000.0, *CacheFile);
+		}
+	}
+}
+
+
+//----------------------------------------------------------------------------------------------------
+// Developer benchmarks
+//----------------------------------------------------------------------------------------------------
+
+#if IMGUI_MODULE_DEVELOPER
+
+namespace
+{
+	bool AreAtlasesEqual(const ImFontAtlas& A, const ImFontAtlas& B)
+	{
+		if (A.TexWidth != B.TexWidth || A.TexHeight != B.TexHeight || A.Fonts.Size != B.Fonts.Size
+			|| FMemory::Memcmp(A.TexPixelsAlpha8, B.TexPixelsAlpha8, A.TexWidth * A.TexHeight) != 0
+			|| FMemory::Memcmp(&A.TexUvWhitePixel, &B.TexUvWhitePixel, sizeof(ImVec2)) != 0)
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < A.Fonts.Size; Index++)
+		{
+			const ImFont& FontA = *A.Fonts[Index];
+			const ImFont& FontB = *B.Fonts[Index];
+			if (FontA.Glyphs.Size != FontB.Glyphs.Size || FontA.IndexLookup.Size != FontB.IndexLookup.Size
+				|| FontA.FontSize != FontB.FontSize || FontA.Ascent != FontB.Ascent || FontA.Descent != FontB.Descent
+				|| FontA.EllipsisChar != FontB.EllipsisChar || FontA.FallbackAdvanceX != FontB.FallbackAdvanceX
+				|| FMemory::Memcmp(FontA.Glyphs.Data, FontB.Glyphs.Data, FontA.Glyphs.size_in_bytes()) != 0
+				|| FMemory::Memcmp(FontA.IndexLookup.Data, FontB.IndexLookup.Data, FontA.IndexLookup.size_in_bytes()) != 0
+				|| FMemory::Memcmp(FontA.IndexAdvanceX.Data, FontB.IndexAdvanceX.Data, FontA.IndexAdvanceX.size_in_bytes()) != 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Builds the default atlas from scratch and loads it from a temporary cache file, and verifies that both give the
+	// same pixels and glyph tables.
+	void BenchmarkFontAtlasCache()
+	{
+		const FString CacheFile = FPaths::CreateTempFilename(*FPaths::GetPath(ImGuiFontAtlasCache::GetDefaultCacheFile()),
+			TEXT("FontAtlasBenchmark"), TEXT(".bin"));
+
+		unsigned char* Pixels;
+		int Width, Height;
+
+		ImFontAtlas BuiltAtlas;
+		BuiltAtlas.AddFontDefault();
+		double StartTime = FPlatformTime::Seconds();
+		BuiltAtlas.GetTexDataAsAlpha8(&Pixels, &Width, &Height);
+		const double BuildTime = FPlatformTime::Seconds() - StartTime;
+
+		if (!ImGuiFontAtlasCache::Save(BuiltAtlas, CacheFile))
+		{
+			UE_LOG(LogImGuiFontAtlasCache, Error, TEXT("Failed to save '%s'."), *CacheFile);
+			return;
+		}
+
+		ImFontAtlas LoadedAtlas;
+		LoadedAtlas.AddFontDefault();
+		StartTime = FPlatformTime::Seconds();
+		const bool bLoaded = ImGuiFontAtlasCache::Load(LoadedAtlas, CacheFile);
+		const double LoadTime = FPlatformTime::Seconds() - StartTime;
+
+		IFileManager::Get().Delete(*CacheFile);
+
+		if (!bLoaded)
+		{
+			UE_LOG(LogImGuiFontAtlasCache, Error, TEXT("Failed to load '%s'."), *CacheFile);
+		}
+		else if (!AreAtlasesEqual(BuiltAtlas, LoadedAtlas))
+		{
+			UE_LOG(LogImGuiFontAtlasCache, Error, TEXT("Loaded font atlas differs from the built one."));
+		}
+		else
+		{
+			UE_LOG(LogImGuiFontAtlasCache, Display, TEXT("Font atlas %dx%d: build %.3f ms, load from cache %.3f ms."),
+				Width, Height, BuildTime * 1000.0, LoadTime * 1000.0);
+		}
+	}
+
+	FAutoConsoleCommand BenchmarkFontAtlasCacheCommand(TEXT("ImGui.Debug.BenchmarkFontAtlasCache"),
+		TEXT("Compare building the default font atlas with loading it from cache and verify that both are identical."),
+		FConsoleCommandDelegate::CreateStatic(&BenchmarkFontAtlasCache));
+}
+
+#endif // IMGUI_MODULE_DEVELOPER
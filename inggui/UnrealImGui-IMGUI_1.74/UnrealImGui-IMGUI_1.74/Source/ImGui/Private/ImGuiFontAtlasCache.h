@@ -0,0 +1,41 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Core.h>
+
+#include <imgui.h>
+
+
+// Cache of built font atlases. Atlas pixels and glyph tables are stored in a binary file together with a key
+// calculated from the atlas configuration, so fonts only need to be rasterized after the configuration changes.
+namespace ImGuiFontAtlasCache
+{
+	// Get the default path of the cache file.
+	FString GetDefaultCacheFile();
+
+	// Calculate a key that identifies atlas configuration: font data, font configs, glyph ranges and custom rectangles.
+	// @param Atlas - The atlas with fonts added, which if not built, needs to have default custom rectangles registered
+	//     (see ImGuiImplementation::RegisterDefaultCustomRects)
+	// @returns The key of the atlas configuration
+	uint32 CalculateKey(const ImFontAtlas& Atlas);
+
+	// Load a built atlas from a cache file. The atlas needs to have the same fonts and custom rectangles that it had when
+	// it was saved, but not be built yet.
+	// @param Atlas - The atlas to load
+	// @param CacheFile - Path to the cache file
+	// @returns True, if the atlas was loaded and false, if the file is missing, invalid or has a different key
+	bool Load(ImFontAtlas& Atlas, const FString& CacheFile);
+
+	// Save a built atlas to a cache file.
+	// @param Atlas - The built atlas
+	// @param CacheFile - Path to the cache file
+	// @returns True, if the file was saved and false otherwise
+	bool Save(const ImFontAtlas& Atlas, const FString& CacheFile);
+
+	// Load an atlas from a cache file, or build it and update the cache, if the file doesn't match the atlas. Adds the
+	// default font, if the atlas has no fonts.
+	// @param Atlas - The atlas to build
+	// @param CacheFile - Path to the cache file
+	void Build(ImFontAtlas& Atlas, const FString& CacheFile = GetDefaultCacheFile());
+}
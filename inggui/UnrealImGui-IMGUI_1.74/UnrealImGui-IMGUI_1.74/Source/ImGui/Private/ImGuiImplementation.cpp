@@ -15,14 +15,21 @@
 #define IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS
 #endif // PLATFORM_XBOXONE
 
-#if WITH_EDITOR
 // Global ImGui context pointer.
 ImGuiContext* GImGuiContextPtr = nullptr;
+#if WITH_EDITOR
 // Handle to the global ImGui context pointer.
 ImGuiContext** GImGuiContextPtrHandle = &GImGuiContextPtr;
-// Get the global ImGui context pointer (GImGui) indirectly to allow redirections in obsolete modules.
-#define GImGui (*GImGuiContextPtrHandle)
+// Get the global ImGui context pointer indirectly to allow redirections in obsolete modules.
+#define GImGuiGlobalContextPtr (*GImGuiContextPtrHandle)
+#else
+#define GImGuiGlobalContextPtr GImGuiContextPtr
 #endif // WITH_EDITOR
+// Handle to the ImGui context pointer of this thread, set only while contexts are updated in parallel (see
+// ImGuiImplementation::FScopedThreadContext).
+thread_local ImGuiContext** GImGuiThreadContextPtrHandle = nullptr;
+// Get the ImGui context pointer of this thread or, if there is none, the global one.
+#define GImGui (*(GImGuiThreadContextPtrHandle ? GImGuiThreadContextPtrHandle : &GImGuiGlobalContextPtr))
 
 #if PLATFORM_WINDOWS
 #include <Windows/AllowWindowsPlatformTypes.h>
@@ -40,8 +47,67 @@ ImGuiContext** GImGuiContextPtrHandle = &GImGuiContextPtr;
 #include "ImGuiInteroperability.h"
 
 
+namespace
+{
+	FThreadSafeCounter NumImGuiAllocations;
+	thread_local uint32 NumThreadImGuiAllocations = 0;
+
+	void* ImGuiMalloc(size_t Size, void*)
+	{
+		NumImGuiAllocations.Increment();
+		NumThreadImGuiAllocations++;
+		return FMemory::Malloc(Size);
+	}
+
+	void ImGuiFree(void* Ptr, void*)
+	{
+		FMemory::Free(Ptr);
+	}
+}
+
 namespace ImGuiImplementation
 {
+	void SetAllocatorFunctions()
+	{
+		ImGui::SetAllocatorFunctions(&ImGuiMalloc, &ImGuiFree);
+	}
+
+	uint32 GetNumAllocations()
+	{
+		return static_cast<uint32>(NumImGuiAllocations.GetValue());
+	}
+
+	uint32 GetNumThreadAllocations()
+	{
+		return NumThreadImGuiAllocations;
+	}
+
+	ImVec2 GetCursorMaxPos()
+	{
+		return ImGui::GetCurrentWindowRead()->DC.CursorMaxPos;
+	}
+
+	ImGuiID GetWindowId(const char* Name)
+	{
+		return ImHashStr(Name);
+	}
+
+	void RegisterDefaultCustomRects(ImFontAtlas& Atlas)
+	{
+		ImFontAtlasBuildRegisterDefaultCustomRects(&Atlas);
+	}
+
+	FScopedThreadContext::FScopedThreadContext()
+		: PreviousHandle(GImGuiThreadContextPtrHandle)
+	{
+		GImGuiThreadContextPtrHandle = &Context;
+	}
+
+	FScopedThreadContext::~FScopedThreadContext()
+	{
+		GImGuiThreadContextPtrHandle = PreviousHandle;
+	}
+
 #if WITH_EDITOR
 	ImGuiContext** GetImGuiContextHandle()
 	{
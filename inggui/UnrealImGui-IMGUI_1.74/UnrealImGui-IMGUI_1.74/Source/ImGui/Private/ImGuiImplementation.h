@@ -8,6 +8,47 @@
 // Gives access to selected ImGui implementation features.
 namespace ImGuiImplementation
 {
+	// Route ImGui allocations through the engine allocator and count them. Needs to be called before creating any
+	// ImGui context or font atlas.
+	void SetAllocatorFunctions();
+
+	// Get the number of allocations made by ImGui since allocator functions were set.
+	uint32 GetNumAllocations();
+
+	// Get the number of allocations made by ImGui on the calling thread.
+	uint32 GetNumThreadAllocations();
+
+	// Get the maximum cursor position reached in the current window, in screen space. Together with the content start
+	// position it gives the size of submitted content.
+	ImVec2 GetCursorMaxPos();
+
+	// Get the ID that ImGui assigns to a window with the given name. It doesn't depend on the ID stack, so it is the same
+	// before and after the window is created.
+	ImGuiID GetWindowId(const char* Name);
+
+	// Add custom rectangles that ImGui adds to font atlas during build (mouse cursors and white pixel), so the atlas
+	// layout can be described before it is built. Does nothing, if they were already added.
+	void RegisterDefaultCustomRects(ImFontAtlas& Atlas);
+
+	// While in scope, ImGui context switches on this thread are local to it and don't affect other threads, so different
+	// contexts can be updated in parallel. The thread starts the scope without a current context and restores its
+	// previous context at the end.
+	class FScopedThreadContext
+	{
+	public:
+
+		FScopedThreadContext();
+		~FScopedThreadContext();
+
+		FScopedThreadContext(const FScopedThreadContext&) = delete;
+		FScopedThreadContext& operator=(const FScopedThreadContext&) = delete;
+
+	private:
+
+		ImGuiContext* Context = nullptr;
+		ImGuiContext** PreviousHandle = nullptr;
+	};
+
 #if WITH_EDITOR
 	// Get the handle to the ImGui Context pointer.
 	ImGuiContext** GetImGuiContextHandle();
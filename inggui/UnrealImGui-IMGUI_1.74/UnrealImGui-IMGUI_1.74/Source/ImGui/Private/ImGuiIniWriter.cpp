@@ -0,0 +1,70 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiIniWriter.h"
+
+#include <Misc/FileHelper.h>
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiIniWriter, Log, All);
+
+FImGuiIniWriter::~FImGuiIniWriter()
+{
+	Flush(true);
+}
+
+void FImGuiIniWriter::Queue(const FString& File, TArray<uint8>&& Data)
+{
+	QueuedFiles.Add(File, MoveTemp(Data));
+}
+
+void FImGuiIniWriter::Flush(bool bWait)
+{
+	if (WriteTask.IsValid())
+	{
+		if (!bWait && !WriteTask->IsComplete())
+		{
+			return;
+		}
+
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(WriteTask);
+		WriteTask.SafeRelease();
+	}
+
+	if (QueuedFiles.Num() == 0)
+	{
+		return;
+	}
+
+	if (bWait)
+	{
+		WriteFiles(QueuedFiles);
+	}
+	else
+	{
+		WriteTask = FFunctionGraphTask::CreateAndDispatchWhenReady([Files = MoveTemp(QueuedFiles)]()
+		{
+			WriteFiles(Files);
+		}, TStatId{}, nullptr, ENamedThreads::AnyBackgroundThreadNormalTask);
+	}
+
+	QueuedFiles.Reset();
+}
+
+void FImGuiIniWriter::WriteFiles(const TMap<FString, TArray<uint8>>& Files)
+{
+	IFileManager& FileManager = IFileManager::Get();
+
+	for (const auto& Pair : Files)
+	{
+		const FString& File = Pair.Key;
+		const FString TempFile = File + TEXT(".tmp");
+
+		if (!FFileHelper::SaveArrayToFile(Pair.Value, *TempFile) || !FileManager.Move(*File, *TempFile, true, true))
+		{
+			UE_LOG(LogImGuiIniWriter, Warning, TEXT("Failed to write ImGui settings to '%s'."), *File);
+			FileManager.Delete(*TempFile, false, true, true);
+		}
+	}
+}
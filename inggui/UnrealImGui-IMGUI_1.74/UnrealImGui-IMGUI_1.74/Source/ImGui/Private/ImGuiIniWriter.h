@@ -0,0 +1,37 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Core.h>
+#include <Async/TaskGraphInterfaces.h>
+
+
+// Writes ImGui ini files on a background thread. Files queued between flushes are written together in one task. Each
+// file is first written to a temporary file, which then replaces the target, so an interrupted write never leaves
+// a partial ini file.
+class FImGuiIniWriter
+{
+public:
+
+	FImGuiIniWriter() = default;
+	~FImGuiIniWriter();
+
+	FImGuiIniWriter(const FImGuiIniWriter&) = delete;
+	FImGuiIniWriter& operator=(const FImGuiIniWriter&) = delete;
+
+	// Queue data to be written to a file. Replaces data queued for the same file, if they were not written yet.
+	// @param File - Path to the target file
+	// @param Data - Content of the file
+	void Queue(const FString& File, TArray<uint8>&& Data);
+
+	// Start writing queued files. Without waiting, files stay queued until the previous write task is finished.
+	// @param bWait - If true, waits for the previous task and writes queued files on this thread
+	void Flush(bool bWait = false);
+
+private:
+
+	static void WriteFiles(const TMap<FString, TArray<uint8>>& Files);
+
+	TMap<FString, TArray<uint8>> QueuedFiles;
+	FGraphEventRef WriteTask;
+};
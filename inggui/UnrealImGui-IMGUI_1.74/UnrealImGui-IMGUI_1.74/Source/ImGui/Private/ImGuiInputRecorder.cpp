@@ -0,0 +1,69 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiInputRecorder.h"
+
+
+FImGuiInputRecorder::FImGuiInputRecorder()
+	// Position that input cannot have, so it is recorded in the first frame.
+	: MousePosition(-FLT_MAX, -FLT_MAX)
+{
+	FMemory::Memzero(KeysDown);
+	FMemory::Memzero(MouseButtonsDown);
+}
+
+void FImGuiInputRecorder::RecordFrame(float DeltaSeconds, const FImGuiInputState& InputState)
+{
+	Stream.AddFrame(DeltaSeconds);
+
+	if (InputState.IsControlDown() != bIsControlDown || InputState.IsShiftDown() != bIsShiftDown
+		|| InputState.IsAltDown() != bIsAltDown)
+	{
+		bIsControlDown = InputState.IsControlDown();
+		bIsShiftDown = InputState.IsShiftDown();
+		bIsAltDown = InputState.IsAltDown();
+		Stream.AddModifiers(bIsControlDown, bIsShiftDown, bIsAltDown);
+	}
+
+	// Mouse moves are recorded before buttons, because input state doesn't apply moves queued after button changes
+	// in the same frame.
+	if (InputState.GetMousePosition() != MousePosition)
+	{
+		MousePosition = InputState.GetMousePosition();
+		Stream.AddMousePosition(MousePosition);
+	}
+
+	if (InputState.GetMouseWheelDelta() != 0.f)
+	{
+		Stream.AddMouseWheelDelta(InputState.GetMouseWheelDelta());
+	}
+
+	// Only dirty parts of arrays can change in this frame.
+	const FImGuiInputState::FKeysIndexRange& KeysRange = InputState.GetKeysUpdateRange();
+	for (uint32 KeyIndex = KeysRange.GetBegin(); KeyIndex < KeysRange.GetEnd(); KeyIndex++)
+	{
+		const bool bIsDown = InputState.GetKeys()[KeyIndex];
+		if (bIsDown != KeysDown[KeyIndex])
+		{
+			KeysDown[KeyIndex] = bIsDown;
+			Stream.AddKey(KeyIndex, bIsDown);
+		}
+	}
+
+	const FImGuiInputState::FMouseButtonsIndexRange& MouseButtonsRange = InputState.GetMouseButtonsUpdateRange();
+	for (uint32 MouseIndex = MouseButtonsRange.GetBegin(); MouseIndex < MouseButtonsRange.GetEnd(); MouseIndex++)
+	{
+		const bool bIsDown = InputState.GetMouseButtons()[MouseIndex];
+		if (bIsDown != MouseButtonsDown[MouseIndex])
+		{
+			MouseButtonsDown[MouseIndex] = bIsDown;
+			Stream.AddMouseButton(MouseIndex, bIsDown);
+		}
+	}
+
+	for (const TCHAR Char : InputState.GetCharacters())
+	{
+		Stream.AddCharacter(Char);
+	}
+}
@@ -0,0 +1,37 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "ImGuiInputState.h"
+#include "ImGuiInputStream.h"
+
+
+// Records input applied to a context in every frame as a stream of changes, which replayed from the beginning
+// reproduce the same input state. Touch and gamepad navigation input is not recorded.
+class FImGuiInputRecorder
+{
+public:
+
+	FImGuiInputRecorder();
+
+	// Record a frame. Needs to be called after queued events are applied to the input state and before its update
+	// state is cleared.
+	// @param DeltaSeconds - Time of the frame
+	// @param InputState - Input state with events applied in this frame
+	void RecordFrame(float DeltaSeconds, const FImGuiInputState& InputState);
+
+	// Get the recorded stream.
+	const FImGuiInputStream& GetStream() const { return Stream; }
+
+private:
+
+	FImGuiInputStream Stream;
+
+	// Input state as it is after replaying recorded frames.
+	FImGuiInputState::FKeysArray KeysDown;
+	FImGuiInputState::FMouseButtonsArray MouseButtonsDown;
+	FVector2D MousePosition;
+	bool bIsControlDown = false;
+	bool bIsShiftDown = false;
+	bool bIsAltDown = false;
+};
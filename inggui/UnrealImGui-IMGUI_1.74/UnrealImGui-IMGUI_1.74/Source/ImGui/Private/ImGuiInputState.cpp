@@ -16,17 +16,112 @@ FImGuiInputState::FImGuiInputState()
 
 void FImGuiInputState::AddCharacter(TCHAR Char)
 {
-	InputCharacters.Add(Char);
+	QueueEvent(EEventType::Character).Index = static_cast<uint32>(Char);
+}
+
+void FImGuiInputState::AddMouseWheelDelta(float DeltaValue)
+{
+	FInputEvent* LastEvent = GetLastQueuedEvent();
+	if (LastEvent && LastEvent->Type == EEventType::MouseWheel)
+	{
+		LastEvent->Value.X += DeltaValue;
+		NumCoalescedEvents++;
+	}
+	else
+	{
+		QueueEvent(EEventType::MouseWheel).Value.X = DeltaValue;
+	}
+}
+
+void FImGuiInputState::SetMousePosition(const FVector2D& Position)
+{
+	if (Position == QueuedMousePosition)
+	{
+		NumCoalescedEvents++;
+		return;
+	}
+
+	QueuedMousePosition = Position;
+
+	// Only the last position of consecutive moves matters.
+	FInputEvent* LastEvent = GetLastQueuedEvent();
+	if (LastEvent && LastEvent->Type == EEventType::MousePosition)
+	{
+		LastEvent->Value = Position;
+		NumCoalescedEvents++;
+	}
+	else
+	{
+		QueueEvent(EEventType::MousePosition).Value = Position;
+	}
+}
+
+FImGuiInputState::FAppliedEvents FImGuiInputState::ApplyQueuedEvents()
+{
+	FAppliedEvents Applied;
+	Applied.NumCoalesced = NumCoalescedEvents;
+	NumCoalescedEvents = 0;
+
+	// State from the beginning of the frame, so we can tell which keys and buttons already changed.
+	using std::copy;
+	FKeysArray FrameKeysDown;
+	copy(KeysDown, &KeysDown[Utilities::GetArraySize(KeysDown)], FrameKeysDown);
+	FMouseButtonsArray FrameMouseButtonsDown;
+	copy(MouseButtonsDown, &MouseButtonsDown[Utilities::GetArraySize(MouseButtonsDown)], FrameMouseButtonsDown);
+
+	bool bMouseButtonChanged = false;
+
+	while (NumQueuedEvents > 0)
+	{
+		const FInputEvent& Event = QueuedEvents[FirstQueuedEvent];
+
+		// ImGui sees only one state per frame, so a second change would cancel the first one.
+		if (Event.Type == EEventType::Key && KeysDown[Event.Index] != FrameKeysDown[Event.Index])
+		{
+			break;
+		}
+
+		if (Event.Type == EEventType::MouseButton && MouseButtonsDown[Event.Index] != FrameMouseButtonsDown[Event.Index])
+		{
+			break;
+		}
+
+		// ImGui takes click position from the frame in which button changed, so moves after it need to wait.
+		if (Event.Type == EEventType::MousePosition && bMouseButtonChanged)
+		{
+			break;
+		}
+
+		if (Applied.NumApplied == 0)
+		{
+			Applied.OldestTimestamp = Event.Timestamp;
+		}
+
+		bMouseButtonChanged |= (Event.Type == EEventType::MouseButton);
+		ApplyEvent(Event);
+		PopQueuedEvent();
+		Applied.NumApplied++;
+	}
+
+	return Applied;
 }
 
 void FImGuiInputState::SetKeyDown(uint32 KeyIndex, bool bIsDown)
 {
 	if (KeyIndex < Utilities::GetArraySize(KeysDown))
 	{
-		if (KeysDown[KeyIndex] != bIsDown)
+		if (QueuedKeysDown[KeyIndex] != bIsDown)
+		{
+			QueuedKeysDown[KeyIndex] = bIsDown;
+
+			FInputEvent& Event = QueueEvent(EEventType::Key);
+			Event.Index = KeyIndex;
+			Event.bIsDown = bIsDown;
+		}
+		else
 		{
-			KeysDown[KeyIndex] = bIsDown;
-			KeysUpdateRange.AddPosition(KeyIndex);
+			// Key repeats or releases of keys that are already up.
+			NumCoalescedEvents++;
 		}
 	}
 }
@@ -35,14 +130,109 @@ void FImGuiInputState::SetMouseDown(uint32 MouseIndex, bool bIsDown)
 {
 	if (MouseIndex < Utilities::GetArraySize(MouseButtonsDown))
 	{
-		if (MouseButtonsDown[MouseIndex] != bIsDown)
+		if (QueuedMouseButtonsDown[MouseIndex] != bIsDown)
+		{
+			QueuedMouseButtonsDown[MouseIndex] = bIsDown;
+
+			FInputEvent& Event = QueueEvent(EEventType::MouseButton);
+			Event.Index = MouseIndex;
+			Event.bIsDown = bIsDown;
+		}
+		else
 		{
-			MouseButtonsDown[MouseIndex] = bIsDown;
-			MouseButtonsUpdateRange.AddPosition(MouseIndex);
+			NumCoalescedEvents++;
 		}
 	}
 }
 
+void FImGuiInputState::ApplyKeyDown(uint32 KeyIndex, bool bIsDown)
+{
+	if (KeysDown[KeyIndex] != bIsDown)
+	{
+		KeysDown[KeyIndex] = bIsDown;
+		KeysUpdateRange.AddPosition(KeyIndex);
+	}
+}
+
+void FImGuiInputState::ApplyMouseDown(uint32 MouseIndex, bool bIsDown)
+{
+	if (MouseButtonsDown[MouseIndex] != bIsDown)
+	{
+		MouseButtonsDown[MouseIndex] = bIsDown;
+		MouseButtonsUpdateRange.AddPosition(MouseIndex);
+	}
+}
+
+void FImGuiInputState::ApplyEvent(const FInputEvent& Event)
+{
+	switch (Event.Type)
+	{
+	case EEventType::Key:
+		ApplyKeyDown(Event.Index, Event.bIsDown);
+		break;
+	case EEventType::Character:
+		InputCharacters.Add(static_cast<TCHAR>(Event.Index));
+		break;
+	case EEventType::MouseButton:
+		ApplyMouseDown(Event.Index, Event.bIsDown);
+		break;
+	case EEventType::MousePosition:
+		MousePosition = Event.Value;
+		break;
+	case EEventType::MouseWheel:
+		MouseWheelDelta += Event.Value.X;
+		break;
+	}
+}
+
+FImGuiInputState::FInputEvent& FImGuiInputState::QueueEvent(EEventType Type)
+{
+	// If frames don't keep up with input, the oldest events lose their frame separation rather than being dropped.
+	if (NumQueuedEvents == MaxQueuedEvents)
+	{
+		ApplyEvent(QueuedEvents[FirstQueuedEvent]);
+		PopQueuedEvent();
+	}
+
+	FInputEvent& Event = QueuedEvents[(FirstQueuedEvent + NumQueuedEvents) % MaxQueuedEvents];
+	NumQueuedEvents++;
+
+	Event.Timestamp = FPlatformTime::Seconds();
+	Event.Value = FVector2D::ZeroVector;
+	Event.Index = 0;
+	Event.Type = Type;
+	Event.bIsDown = false;
+
+	return Event;
+}
+
+FImGuiInputState::FInputEvent* FImGuiInputState::GetLastQueuedEvent()
+{
+	return NumQueuedEvents > 0 ? &QueuedEvents[(FirstQueuedEvent + NumQueuedEvents - 1) % MaxQueuedEvents] : nullptr;
+}
+
+void FImGuiInputState::PopQueuedEvent()
+{
+	FirstQueuedEvent = (FirstQueuedEvent + 1) % MaxQueuedEvents;
+	NumQueuedEvents--;
+}
+
+void FImGuiInputState::RemoveQueuedEvents(uint32 TypeMask)
+{
+	int32 NumKept = 0;
+	for (int32 Offset = 0; Offset < NumQueuedEvents; Offset++)
+	{
+		const FInputEvent& Event = QueuedEvents[(FirstQueuedEvent + Offset) % MaxQueuedEvents];
+		if ((TypeMask & (1u << static_cast<uint32>(Event.Type))) == 0)
+		{
+			QueuedEvents[(FirstQueuedEvent + NumKept) % MaxQueuedEvents] = Event;
+			NumKept++;
+		}
+	}
+
+	NumQueuedEvents = NumKept;
+}
+
 void FImGuiInputState::ClearUpdateState()
 {
 	ClearCharacters();
@@ -64,6 +254,10 @@ void FImGuiInputState::ClearKeys()
 {
 	using std::fill;
 	fill(KeysDown, &KeysDown[Utilities::GetArraySize(KeysDown)], false);
+	fill(QueuedKeysDown, &QueuedKeysDown[Utilities::GetArraySize(QueuedKeysDown)], false);
+
+	// Characters typed with cleared keys are dropped together with them.
+	RemoveQueuedEvents((1u << static_cast<uint32>(EEventType::Key)) | (1u << static_cast<uint32>(EEventType::Character)));
 
 	// Mark the whole array as dirty because potentially each entry could be affected.
 	KeysUpdateRange.SetFull();
@@ -73,6 +267,8 @@ void FImGuiInputState::ClearMouseButtons()
 {
 	using std::fill;
 	fill(MouseButtonsDown, &MouseButtonsDown[Utilities::GetArraySize(MouseButtonsDown)], false);
+	fill(QueuedMouseButtonsDown, &QueuedMouseButtonsDown[Utilities::GetArraySize(QueuedMouseButtonsDown)], false);
+	RemoveQueuedEvents(1u << static_cast<uint32>(EEventType::MouseButton));
 
 	// Mark the whole array as dirty because potentially each entry could be affected.
 	MouseButtonsUpdateRange.SetFull();
@@ -81,7 +277,9 @@ void FImGuiInputState::ClearMouseButtons()
 void FImGuiInputState::ClearMouseAnalogue()
 {
 	MousePosition = FVector2D::ZeroVector;
+	QueuedMousePosition = FVector2D::ZeroVector;
 	MouseWheelDelta = 0.f;
+	RemoveQueuedEvents((1u << static_cast<uint32>(EEventType::MousePosition)) | (1u << static_cast<uint32>(EEventType::MouseWheel)));
 }
 
 void FImGuiInputState::ClearModifierKeys()
@@ -97,3 +295,95 @@ void FImGuiInputState::ClearNavigationInputs()
 	fill(NavigationInputs, &NavigationInputs[Utilities::GetArraySize(NavigationInputs)], 0.f);
 }
 
+
+
+//----------------------------------------------------------------------------------------------------
+// Developer benchmarks
+//----------------------------------------------------------------------------------------------------
+
+#if IMGUI_MODULE_DEVELOPER
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiInputState, Log, All);
+
+namespace
+{
+	// Feeds a separate input state with bursts of mouse moves, wheel deltas and key repeats, and with quick clicks that
+	// start and end within one frame. Measures the cost of queueing and applying events and verifies that every click
+	// reaches the state as a separate press and release.
+	void BenchmarkInputQueue(const TArray<FString>& Args)
+	{
+		const int32 NumFrames = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10000;
+		const int32 NumMovesPerFrame = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 0) : 32;
+
+		// One click every few frames, so the queue can catch up with split presses and releases.
+		constexpr int32 ClickInterval = 4;
+
+		FImGuiInputState InputState;
+		FRandomStream Random{ 0x1490 };
+
+		int32 NumClicks = 0, NumPresses = 0, NumReleases = 0;
+		int64 NumReceived = 0, NumApplied = 0, NumCoalesced = 0;
+		bool bWasDown = false;
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		// A few extra frames allow the queue to drain.
+		for (int32 Frame = 0; Frame < NumFrames + ClickInterval; Frame++)
+		{
+			if (Frame < NumFrames)
+			{
+				for (int32 Move = 0; Move < NumMovesPerFrame; Move++)
+				{
+					InputState.SetMousePosition({ Random.FRandRange(0.f, 1920.f), Random.FRandRange(0.f, 1080.f) });
+				}
+				for (int32 Scroll = 0; Scroll < NumMovesPerFrame; Scroll++)
+				{
+					InputState.AddMouseWheelDelta(0.25f);
+				}
+				for (int32 Repeat = 0; Repeat < NumMovesPerFrame; Repeat++)
+				{
+					InputState.SetKeyDown(EKeys::A, true);
+				}
+				NumReceived += NumMovesPerFrame * 3;
+
+				if (Frame % ClickInterval == 0)
+				{
+					InputState.SetMouseDown(EKeys::LeftMouseButton, true);
+					InputState.SetMousePosition({ Random.FRandRange(0.f, 1920.f), Random.FRandRange(0.f, 1080.f) });
+					InputState.SetMouseDown(EKeys::LeftMouseButton, false);
+					NumReceived += 3;
+					NumClicks++;
+				}
+			}
+
+			const FImGuiInputState::FAppliedEvents Applied = InputState.ApplyQueuedEvents();
+			NumApplied += Applied.NumApplied;
+			NumCoalesced += Applied.NumCoalesced;
+
+			const bool bIsDown = InputState.GetMouseButtons()[0];
+			NumPresses += (bIsDown && !bWasDown) ? 1 : 0;
+			NumReleases += (!bIsDown && bWasDown) ? 1 : 0;
+			bWasDown = bIsDown;
+
+			InputState.ClearUpdateState();
+		}
+
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogImGuiInputState, Display, TEXT("%d frames: %lld events received, %lld applied, %lld coalesced, %.3f us per frame."),
+			NumFrames, NumReceived, NumApplied, NumCoalesced, Seconds * 1000000.0 / NumFrames);
+
+		if (NumPresses != NumClicks || NumReleases != NumClicks || InputState.GetNumQueuedEvents() > 0)
+		{
+			UE_LOG(LogImGuiInputState, Error, TEXT("%d clicks gave %d presses and %d releases, %d events left in the queue."),
+				NumClicks, NumPresses, NumReleases, InputState.GetNumQueuedEvents());
+		}
+	}
+
+	FAutoConsoleCommand BenchmarkInputQueueCommand(TEXT("ImGui.Debug.BenchmarkInputQueue"),
+		TEXT("Feed a separate input state with bursts of events and quick clicks, and measure queueing and applying them.\n")
+		TEXT("Arguments: [NumFrames] (default 10000) [NumMovesPerFrame] (default 32)"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkInputQueue));
+}
+
+#endif // IMGUI_MODULE_DEVELOPER
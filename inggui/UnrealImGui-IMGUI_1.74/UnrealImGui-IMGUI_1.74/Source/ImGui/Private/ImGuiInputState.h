@@ -9,6 +9,12 @@
 
 
 // Collects and stores input state and updates for ImGui IO.
+//
+// Key, character, mouse button, mouse move and mouse wheel events are queued in one queue and applied at the beginning
+// of a frame, in order they were received, so characters stay in order with keys pressed before and after them. Redundant
+// events, like key repeats, consecutive mouse moves and wheel deltas, are coalesced when they are queued. A key or
+// button can change only once per frame, so quick presses and releases that happen within one frame are split between
+// frames rather than lost.
 class FImGuiInputState
 {
 public:
@@ -31,14 +37,30 @@ public:
 	// Pair of indices defining range in keys array.
 	using FKeysIndexRange = Utilities::TArrayIndexRange<FKeysArray, uint32>;
 
+	// Maximum number of queued events. When the queue is full, the oldest event is applied immediately.
+	static constexpr int32 MaxQueuedEvents = 128;
+
+	// Summary of events applied in one frame.
+	struct FAppliedEvents
+	{
+		// Number of applied events.
+		int32 NumApplied = 0;
+
+		// Number of events that were merged with other events or dropped as redundant since the last frame.
+		int32 NumCoalesced = 0;
+
+		// Time of the oldest applied event in seconds, as returned by FPlatformTime::Seconds.
+		double OldestTimestamp = 0.0;
+	};
+
 	// Create empty state with whole range instance with the whole update state marked as dirty.
 	FImGuiInputState();
 
 	// Get reference to input characters buffer.
 	const FCharactersBuffer& GetCharacters() const { return InputCharacters; }
 
-	// Add a character to the characters buffer. We can store and send to ImGui up to 16 characters per frame. Any
-	// character beyond that limit will be discarded.
+	// Queue a character. When applied, it is added to the characters buffer. We can store and send to ImGui up to 16
+	// characters per frame. Any character beyond that limit will be discarded.
 	// @param Char - Character to add
 	void AddCharacter(TCHAR Char);
 
@@ -48,45 +70,61 @@ public:
 	// Get possibly empty range of indices bounding dirty part of the keys array.
 	const FKeysIndexRange& GetKeysUpdateRange() const { return KeysUpdateRange; }
 
-	// Change state of the key in the keys array and expand range bounding dirty part of the array.
+	// Queue a change of the key state. When applied, it changes state in the keys array and expands range bounding
+	// dirty part of the array.
 	// @param KeyEvent - Key event representing the key
 	// @param bIsDown - True, if key is down
 	void SetKeyDown(const FKeyEvent& KeyEvent, bool bIsDown) { SetKeyDown(ImGuiInterops::GetKeyIndex(KeyEvent), bIsDown); }
 
-	// Change state of the key in the keys array and expand range bounding dirty part of the array.
+	// Queue a change of the key state. When applied, it changes state in the keys array and expands range bounding
+	// dirty part of the array.
 	// @param Key - Keyboard key
 	// @param bIsDown - True, if key is down
 	void SetKeyDown(const FKey& Key, bool bIsDown) { SetKeyDown(ImGuiInterops::GetKeyIndex(Key), bIsDown); }
 
+	// Queue a change of the key state, like other overloads but using index in the keys array. Invalid indices are
+	// ignored.
+	// @param KeyIndex - Index of the key in the keys array
+	// @param bIsDown - True, if key is down
+	void SetKeyDown(uint32 KeyIndex, bool bIsDown);
+
 	// Get reference to the array with mouse button down states.
 	const FMouseButtonsArray& GetMouseButtons() const { return MouseButtonsDown; }
 
 	// Get possibly empty range of indices bounding dirty part of the mouse buttons array.
 	const FMouseButtonsIndexRange& GetMouseButtonsUpdateRange() const { return MouseButtonsUpdateRange; }
 
-	// Change state of the button in the mouse buttons array and expand range bounding dirty part of the array.
+	// Queue a change of the button state. When applied, it changes state in the mouse buttons array and expands range
+	// bounding dirty part of the array.
 	// @param MouseEvent - Mouse event representing mouse button
 	// @param bIsDown - True, if button is down
 	void SetMouseDown(const FPointerEvent& MouseEvent, bool bIsDown) { SetMouseDown(ImGuiInterops::GetMouseIndex(MouseEvent), bIsDown); }
 
-	// Change state of the button in the mouse buttons array and expand range bounding dirty part of the array.
+	// Queue a change of the button state. When applied, it changes state in the mouse buttons array and expands range
+	// bounding dirty part of the array.
 	// @param MouseButton - Mouse button key
 	// @param bIsDown - True, if button is down
 	void SetMouseDown(const FKey& MouseButton, bool bIsDown) { SetMouseDown(ImGuiInterops::GetMouseIndex(MouseButton), bIsDown); }
 
+	// Queue a change of the button state, like other overloads but using index in the mouse buttons array. Invalid
+	// indices are ignored.
+	// @param MouseIndex - Index of the button in the mouse buttons array
+	// @param bIsDown - True, if button is down
+	void SetMouseDown(uint32 MouseIndex, bool bIsDown);
+
 	// Get mouse wheel delta accumulated during the last frame.
 	float GetMouseWheelDelta() const { return MouseWheelDelta; }
 
-	// Add mouse wheel delta.
+	// Queue mouse wheel delta. Consecutive deltas are added together.
 	// @param DeltaValue - Mouse wheel delta to add
-	void AddMouseWheelDelta(float DeltaValue) { MouseWheelDelta += DeltaValue; }
+	void AddMouseWheelDelta(float DeltaValue);
 
 	// Get the mouse position.
 	const FVector2D& GetMousePosition() const { return MousePosition; }
 
-	// Set the mouse position.
+	// Queue a change of the mouse position. Consecutive moves are merged into one.
 	// @param Position - Mouse position
-	void SetMousePosition(const FVector2D& Position) { MousePosition = Position; }
+	void SetMousePosition(const FVector2D& Position);
 
 	// Check whether input has active mouse pointer.
 	bool HasMousePointer() const { return bHasMousePointer; }
@@ -197,14 +235,54 @@ public:
 		ClearNavigationInputs();
 	}
 
+	// Apply queued events to the state, in order they were received. Applying stops at the first event that would
+	// change a key or button already changed in this frame, or that would move the mouse after a button changed. That
+	// event and all events after it stay in the queue for the next frame.
+	// @returns Summary of applied events
+	FAppliedEvents ApplyQueuedEvents();
+
+	// Get the number of events waiting in the queue.
+	int32 GetNumQueuedEvents() const { return NumQueuedEvents; }
+
 	// Clear part of the state that is meant to be updated in every frame like: accumulators, buffers, navigation data
 	// and information about dirty parts of keys or mouse buttons arrays.
 	void ClearUpdateState();
 
 private:
 
-	void SetKeyDown(uint32 KeyIndex, bool bIsDown);
-	void SetMouseDown(uint32 MouseIndex, bool IsDown);
+	enum class EEventType : uint8
+	{
+		Key,
+		Character,
+		MouseButton,
+		MousePosition,
+		MouseWheel,
+	};
+
+	struct FInputEvent
+	{
+		double Timestamp;
+
+		// Mouse position or wheel delta in X.
+		FVector2D Value;
+
+		// Index of the key or mouse button, or character code.
+		uint32 Index;
+
+		EEventType Type;
+		bool bIsDown;
+	};
+
+	void ApplyKeyDown(uint32 KeyIndex, bool bIsDown);
+	void ApplyMouseDown(uint32 MouseIndex, bool bIsDown);
+	void ApplyEvent(const FInputEvent& Event);
+
+	FInputEvent& QueueEvent(EEventType Type);
+	FInputEvent* GetLastQueuedEvent();
+	void PopQueuedEvent();
+
+	// Remove queued events of types in a mask (bits shifted by event types).
+	void RemoveQueuedEvents(uint32 TypeMask);
 
 	void ClearCharacters();
 	void ClearKeys();
@@ -227,6 +305,17 @@ private:
 
 	FNavInputArray NavigationInputs;
 
+	// Ring buffer with queued events.
+	FInputEvent QueuedEvents[MaxQueuedEvents];
+	int32 FirstQueuedEvent = 0;
+	int32 NumQueuedEvents = 0;
+	int32 NumCoalescedEvents = 0;
+
+	// State after all queued events are applied, used to drop redundant events.
+	FKeysArray QueuedKeysDown;
+	FMouseButtonsArray QueuedMouseButtonsDown;
+	FVector2D QueuedMousePosition = FVector2D::ZeroVector;
+
 	bool bHasMousePointer = false;
 	bool bTouchDown = false;
 	bool bTouchProcessed = false;
@@ -0,0 +1,214 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiInputStream.h"
+
+#include "ImGuiInputState.h"
+
+#include <Misc/FileHelper.h>
+
+
+namespace
+{
+	constexpr uint32 StreamMagic = 0x53494749; // 'IGIS'
+
+	// Needs to be incremented, whenever the encoding changes.
+	constexpr uint32 StreamVersion = 1;
+
+	// Event type is stored in lower bits of the header byte and flags in upper bits.
+	enum EEventType : uint8
+	{
+		Event_Frame,
+		Event_Key,
+		Event_MouseButton,
+		Event_MousePosition,
+		Event_MouseWheel,
+		Event_Character,
+		Event_Modifiers,
+	};
+
+	constexpr uint8 TypeMask = 0x0F;
+
+	constexpr uint8 Flag_Down = 0x10;
+	constexpr uint8 Flag_Control = 0x10;
+	constexpr uint8 Flag_Shift = 0x20;
+	constexpr uint8 Flag_Alt = 0x40;
+
+	int32 GetPayloadSize(uint8 Type)
+	{
+		switch (Type)
+		{
+		case Event_Frame: return sizeof(float);
+		case Event_Key: return sizeof(uint16);
+		case Event_MouseButton: return sizeof(uint8);
+		case Event_MousePosition: return 2 * sizeof(float);
+		case Event_MouseWheel: return sizeof(float);
+		case Event_Character: return sizeof(uint32);
+		case Event_Modifiers: return 0;
+		default: return INDEX_NONE;
+		}
+	}
+
+	template<typename T>
+	T Read(const uint8* Src)
+	{
+		T Value;
+		FMemory::Memcpy(&Value, Src, sizeof(T));
+		return Value;
+	}
+}
+
+template<typename T>
+void FImGuiInputStream::Write(const T& Value)
+{
+	Data.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+}
+
+void FImGuiInputStream::WriteHeader(uint8 Type, uint8 Flags)
+{
+	checkf(Type == Event_Frame || FrameOffsets.Num() > 0, TEXT("Input events can be only added after the first frame."));
+	Data.Add(Type | Flags);
+}
+
+void FImGuiInputStream::AddFrame(float DeltaSeconds)
+{
+	FrameOffsets.Add(Data.Num());
+	WriteHeader(Event_Frame);
+	Write(DeltaSeconds);
+}
+
+void FImGuiInputStream::AddKey(uint32 KeyIndex, bool bIsDown)
+{
+	WriteHeader(Event_Key, bIsDown ? Flag_Down : 0);
+	Write(static_cast<uint16>(KeyIndex));
+}
+
+void FImGuiInputStream::AddMouseButton(uint32 MouseIndex, bool bIsDown)
+{
+	WriteHeader(Event_MouseButton, bIsDown ? Flag_Down : 0);
+	Write(static_cast<uint8>(MouseIndex));
+}
+
+void FImGuiInputStream::AddMousePosition(const FVector2D& Position)
+{
+	WriteHeader(Event_MousePosition);
+	Write(static_cast<float>(Position.X));
+	Write(static_cast<float>(Position.Y));
+}
+
+void FImGuiInputStream::AddMouseWheelDelta(float Delta)
+{
+	WriteHeader(Event_MouseWheel);
+	Write(Delta);
+}
+
+void FImGuiInputStream::AddCharacter(TCHAR Char)
+{
+	WriteHeader(Event_Character);
+	Write(static_cast<uint32>(Char));
+}
+
+void FImGuiInputStream::AddModifiers(bool bControlDown, bool bShiftDown, bool bAltDown)
+{
+	WriteHeader(Event_Modifiers, (bControlDown ? Flag_Control : 0) | (bShiftDown ? Flag_Shift : 0) | (bAltDown ? Flag_Alt : 0));
+}
+
+float FImGuiInputStream::GetDeltaSeconds(int32 Frame) const
+{
+	return Read<float>(&Data[FrameOffsets[Frame] + 1]);
+}
+
+void FImGuiInputStream::Apply(int32 Frame, FImGuiInputState& InputState) const
+{
+	const int32 End = (Frame + 1 < FrameOffsets.Num()) ? FrameOffsets[Frame + 1] : Data.Num();
+
+	// Skip the frame header.
+	int32 Offset = FrameOffsets[Frame] + 1 + GetPayloadSize(Event_Frame);
+
+	while (Offset < End)
+	{
+		const uint8 Header = Data[Offset];
+		const uint8* Payload = &Data[Offset + 1];
+		const bool bFlagDown = (Header & Flag_Down) != 0;
+
+		switch (Header & TypeMask)
+		{
+		case Event_Key:
+			InputState.SetKeyDown(static_cast<uint32>(Read<uint16>(Payload)), bFlagDown);
+			break;
+		case Event_MouseButton:
+			InputState.SetMouseDown(static_cast<uint32>(Read<uint8>(Payload)), bFlagDown);
+			break;
+		case Event_MousePosition:
+			InputState.SetMousePosition({ Read<float>(Payload), Read<float>(Payload + sizeof(float)) });
+			break;
+		case Event_MouseWheel:
+			InputState.AddMouseWheelDelta(Read<float>(Payload));
+			break;
+		case Event_Character:
+			InputState.AddCharacter(static_cast<TCHAR>(Read<uint32>(Payload)));
+			break;
+		case Event_Modifiers:
+			InputState.SetControlDown((Header & Flag_Control) != 0);
+			InputState.SetShiftDown((Header & Flag_Shift) != 0);
+			InputState.SetAltDown((Header & Flag_Alt) != 0);
+			break;
+		}
+
+		Offset += 1 + GetPayloadSize(Header & TypeMask);
+	}
+}
+
+void FImGuiInputStream::Reset()
+{
+	FrameOffsets.Reset();
+	Data.Reset();
+}
+
+bool FImGuiInputStream::Save(const FString& File) const
+{
+	TArray<uint8> FileData;
+	FileData.Reserve(2 * sizeof(uint32) + Data.Num());
+	FileData.Append(reinterpret_cast<const uint8*>(&StreamMagic), sizeof(StreamMagic));
+	FileData.Append(reinterpret_cast<const uint8*>(&StreamVersion), sizeof(StreamVersion));
+	FileData.Append(Data);
+
+	return FFileHelper::SaveArrayToFile(FileData, *File);
+}
+
+bool FImGuiInputStream::Load(const FString& File)
+{
+	Reset();
+
+	TArray<uint8> FileData;
+	constexpr int32 HeaderSize = 2 * sizeof(uint32);
+	if (!FFileHelper::LoadFileToArray(FileData, *File, FILEREAD_Silent) || FileData.Num() < HeaderSize
+		|| Read<uint32>(&FileData[0]) != StreamMagic || Read<uint32>(&FileData[sizeof(uint32)]) != StreamVersion)
+	{
+		return false;
+	}
+
+	Data.Append(FileData.GetData() + HeaderSize, FileData.Num() - HeaderSize);
+
+	// Find frames and validate that every event is complete, so applying doesn't need to check bounds.
+	for (int32 Offset = 0; Offset < Data.Num();)
+	{
+		const uint8 Type = Data[Offset] & TypeMask;
+		const int32 PayloadSize = GetPayloadSize(Type);
+		if (PayloadSize == INDEX_NONE || Offset + 1 + PayloadSize > Data.Num() || (Offset == 0 && Type != Event_Frame))
+		{
+			Reset();
+			return false;
+		}
+
+		if (Type == Event_Frame)
+		{
+			FrameOffsets.Add(Offset);
+		}
+
+		Offset += 1 + PayloadSize;
+	}
+
+	return true;
+}
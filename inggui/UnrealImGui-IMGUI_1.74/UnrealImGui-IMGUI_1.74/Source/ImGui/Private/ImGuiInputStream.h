@@ -0,0 +1,78 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Core.h>
+
+
+class FImGuiInputState;
+
+// Input of a number of frames, stored as a compact sequence of FImGuiInputState setter calls, so it can be saved to
+// a file and replayed to get the same input state. Each event takes a type byte followed by its payload of at most
+// 8 bytes, and frames start with their delta time.
+class FImGuiInputStream
+{
+public:
+
+	// Start a new frame. Events added after this belong to that frame.
+	// @param DeltaSeconds - Time of the frame
+	void AddFrame(float DeltaSeconds);
+
+	// Add a change of the key state (see FImGuiInputState::SetKeyDown).
+	void AddKey(uint32 KeyIndex, bool bIsDown);
+
+	// Add a change of the mouse button state (see FImGuiInputState::SetMouseDown).
+	void AddMouseButton(uint32 MouseIndex, bool bIsDown);
+
+	// Add a mouse move (see FImGuiInputState::SetMousePosition).
+	void AddMousePosition(const FVector2D& Position);
+
+	// Add mouse wheel delta (see FImGuiInputState::AddMouseWheelDelta).
+	void AddMouseWheelDelta(float Delta);
+
+	// Add a character (see FImGuiInputState::AddCharacter).
+	void AddCharacter(TCHAR Char);
+
+	// Add state of modifier keys (see FImGuiInputState::SetControlDown, SetShiftDown and SetAltDown).
+	void AddModifiers(bool bControlDown, bool bShiftDown, bool bAltDown);
+
+	// Get the number of frames in this stream.
+	int32 GetNumFrames() const { return FrameOffsets.Num(); }
+
+	// Get the size of encoded events in bytes.
+	int32 GetNumBytes() const { return Data.Num(); }
+
+	// Get the time of a frame.
+	// @param Frame - Index of the frame
+	// @returns Delta time of the frame in seconds
+	float GetDeltaSeconds(int32 Frame) const;
+
+	// Apply events of a frame to an input state, in the order they were added.
+	// @param Frame - Index of the frame
+	// @param InputState - The input state to update
+	void Apply(int32 Frame, FImGuiInputState& InputState) const;
+
+	// Remove all frames.
+	void Reset();
+
+	// Save this stream to a file.
+	// @param File - Path to the file
+	// @returns True, if the file was saved and false otherwise
+	bool Save(const FString& File) const;
+
+	// Load this stream from a file, replacing its content.
+	// @param File - Path to the file
+	// @returns True, if the file was loaded and false, if it is missing or invalid, in which case stream is empty
+	bool Load(const FString& File);
+
+private:
+
+	template<typename T>
+	void Write(const T& Value);
+
+	void WriteHeader(uint8 Type, uint8 Flags = 0);
+
+	// Offset of every frame in data.
+	TArray<int32> FrameOffsets;
+	TArray<uint8> Data;
+};
@@ -103,6 +103,12 @@ namespace ImGuiInterops
 		return FVector2D{ ImGuiVector.x, ImGuiVector.y };
 	}
 
+	// Convert from FVector2D to ImVec2.
+	FORCEINLINE ImVec2 ToImVec2(const FVector2D& Vector)
+	{
+		return ImVec2{ static_cast<float>(Vector.X), static_cast<float>(Vector.Y) };
+	}
+
 	// Convert from ImGui Texture Id to Texture Index that we use for texture resources.
 	FORCEINLINE TextureIndex ToTextureIndex(ImTextureID Index)
 	{
@@ -4,14 +4,15 @@
 
 #include "ImGuiModuleManager.h"
 
+#include "ImGuiContextProxy.h"
 #include "ImGuiDelegatesContainer.h"
+#include "ImGuiImplementation.h"
 #include "ImGuiTextureHandle.h"
 #include "TextureManager.h"
 #include "Utilities/WorldContext.h"
 #include "Utilities/WorldContextIndex.h"
 
 #if WITH_EDITOR
-#include "ImGuiImplementation.h"
 #include "Editor/ImGuiEditor.h"
 #endif
 
@@ -139,16 +140,100 @@ FImGuiTextureHandle FImGuiModule::RegisterTexture(const FName& Name, class UText
 	return FImGuiTextureHandle{ Name, ImGuiInterops::ToImTextureID(Index) };
 }
 
+FImGuiTextureHandle FImGuiModule::RegisterTexture(const FName& Name, int32 Width, int32 Height, const FColor* Pixels, bool bMakeUnique, bool bUseAtlas)
+{
+	checkf(Pixels, TEXT("Null Pixels."));
+
+	FTextureManager& TextureManager = ImGuiModuleManager->GetTextureManager();
+
+	if (!bMakeUnique)
+	{
+		ReleaseTexture(FindTextureHandle(Name));
+	}
+
+	TextureIndex Index;
+	if (bUseAtlas)
+	{
+		Index = TextureManager.CreateAtlasTexture(Name, Width, Height, Pixels);
+	}
+	else
+	{
+		const int32 NumPixels = Width * Height;
+		FColor* SrcData = new FColor[NumPixels];
+		FMemory::Memcpy(SrcData, Pixels, NumPixels * sizeof(FColor));
+		Index = TextureManager.CreateTexture(Name, Width, Height, sizeof(FColor), reinterpret_cast<uint8*>(SrcData),
+			[](uint8* Data) { delete[] reinterpret_cast<FColor*>(Data); });
+	}
+
+	return FImGuiTextureHandle{ Name, ImGuiInterops::ToImTextureID(Index) };
+}
+
+void FImGuiModule::UpdateTexture(const FImGuiTextureHandle& Handle, TArrayView<const FIntRect> DirtyRects, const FColor* Pixels, int32 PixelsPitch)
+{
+	if (Handle.IsValid())
+	{
+		FTextureManager& TextureManager = ImGuiModuleManager->GetTextureManager();
+		if (!TextureManager.UpdateAtlasTextureRegions(Handle.GetName(), DirtyRects, Pixels, PixelsPitch))
+		{
+			TextureManager.UpdateTextureRegions(ImGuiInterops::ToTextureIndex(Handle.GetTextureId()), DirtyRects, Pixels, PixelsPitch);
+		}
+	}
+}
+
 void FImGuiModule::ReleaseTexture(const FImGuiTextureHandle& Handle)
 {
 	if (Handle.IsValid())
 	{
-		ImGuiModuleManager->GetTextureManager().ReleaseTextureResources(ImGuiInterops::ToTextureIndex(Handle.GetTextureId()));
+		FTextureManager& TextureManager = ImGuiModuleManager->GetTextureManager();
+		if (!TextureManager.ReleaseAtlasTexture(Handle.GetName()))
+		{
+			TextureManager.ReleaseTextureResources(ImGuiInterops::ToTextureIndex(Handle.GetTextureId()));
+		}
+	}
+}
+
+bool FImGuiModule::BeginCachedWindow(const char* Name, uint32 ContentVersion, bool* bOpen, int Flags)
+{
+	if (FImGuiContextProxy* ContextProxy = FImGuiContextProxy::GetCurrentContextProxy())
+	{
+		return ContextProxy->GetWindowCache().Begin(Name, ContentVersion, bOpen, Flags);
+	}
+
+	return ImGui::Begin(Name, bOpen, Flags);
+}
+
+void FImGuiModule::EndCachedWindow()
+{
+	if (FImGuiContextProxy* ContextProxy = FImGuiContextProxy::GetCurrentContextProxy())
+	{
+		ContextProxy->GetWindowCache().End();
+	}
+	else
+	{
+		ImGui::End();
+	}
+}
+
+void FImGuiModule::InvalidateCachedWindow(const char* Name)
+{
+	if (FImGuiContextProxy* ContextProxy = FImGuiContextProxy::GetCurrentContextProxy())
+	{
+		ContextProxy->GetWindowCache().Invalidate(Name);
 	}
 }
 
+void FImGuiModule::GetCachedWindowCounters(uint32& OutHits, uint32& OutMisses) const
+{
+	const FImGuiContextProxy* ContextProxy = FImGuiContextProxy::GetCurrentContextProxy();
+	OutHits = ContextProxy ? ContextProxy->GetWindowCache().GetNumHits() : 0;
+	OutMisses = ContextProxy ? ContextProxy->GetWindowCache().GetNumMisses() : 0;
+}
+
 void FImGuiModule::StartupModule()
 {
+	// Route ImGui allocations through the engine allocator before any context or font atlas is created.
+	ImGuiImplementation::SetAllocatorFunctions();
+
 	// Create managers that implements module logic.
 
 	checkf(!ImGuiModuleManager, TEXT("Instance of the ImGui Module Manager already exists. Instance should be created only during module startup."));
@@ -341,7 +426,27 @@ FImGuiModuleLoader FImGuiModuleLoader::Instance;
 bool FImGuiTextureHandle::HasValidEntry() const
 {
 	const TextureIndex Index = ImGuiInterops::ToTextureIndex(TextureId);
-	return Index != INDEX_NONE && ImGuiModuleManager && ImGuiModuleManager->GetTextureManager().GetTextureName(Index) == Name;
+	return Index != INDEX_NONE && ImGuiModuleManager && ImGuiModuleManager->GetTextureManager().FindTextureIndex(Name) == Index;
+}
+
+ImVec2 FImGuiTextureHandle::GetUV0() const
+{
+	FVector2D UV0{ 0.f, 0.f }, UV1{ 1.f, 1.f };
+	if (!IsNull() && ImGuiModuleManager)
+	{
+		ImGuiModuleManager->GetTextureManager().GetTextureUVs(Name, UV0, UV1);
+	}
+	return ImGuiInterops::ToImVec2(UV0);
+}
+
+ImVec2 FImGuiTextureHandle::GetUV1() const
+{
+	FVector2D UV0{ 0.f, 0.f }, UV1{ 1.f, 1.f };
+	if (!IsNull() && ImGuiModuleManager)
+	{
+		ImGuiModuleManager->GetTextureManager().GetTextureUVs(Name, UV0, UV1);
+	}
+	return ImGuiInterops::ToImVec2(UV1);
 }
 
 
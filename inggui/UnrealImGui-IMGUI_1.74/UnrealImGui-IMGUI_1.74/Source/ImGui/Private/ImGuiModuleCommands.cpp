@@ -4,8 +4,37 @@
 
 #include "ImGuiModuleCommands.h"
 
+#include "ImGuiContextManager.h"
+#include "ImGuiInputStream.h"
 #include "Utilities/DebugExecBindings.h"
 
+#include <Dom/JsonObject.h>
+#include <Misc/FileHelper.h>
+#include <Serialization/JsonSerializer.h>
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiStats, Log, All);
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiInput, Log, All);
+
+
+namespace
+{
+	FString GetSavedDir()
+	{
+#if ENGINE_COMPATIBILITY_LEGACY_SAVED_DIR
+		return FPaths::Combine(*FPaths::GameSavedDir(), TEXT("ImGui"));
+#else
+		return FPaths::Combine(*FPaths::ProjectSavedDir(), TEXT("ImGui"));
+#endif
+	}
+
+	// Get the file with recorded input of a context.
+	FString GetInputFile(const FString& Directory, const FImGuiContextProxy& ContextProxy)
+	{
+		return FPaths::Combine(*Directory, *(ContextProxy.GetName() + TEXT(".input")));
+	}
+}
+
 
 const TCHAR* const FImGuiModuleCommands::ToggleInput = TEXT("ImGui.ToggleInput");
 const TCHAR* const FImGuiModuleCommands::ToggleKeyboardNavigation = TEXT("ImGui.ToggleKeyboardNavigation");
@@ -14,9 +43,16 @@ const TCHAR* const FImGuiModuleCommands::ToggleKeyboardInputSharing = TEXT("ImGu
 const TCHAR* const FImGuiModuleCommands::ToggleGamepadInputSharing = TEXT("ImGui.ToggleGamepadInputSharing");
 const TCHAR* const FImGuiModuleCommands::ToggleMouseInputSharing = TEXT("ImGui.ToggleMouseInputSharing");
 const TCHAR* const FImGuiModuleCommands::ToggleDemo = TEXT("ImGui.ToggleDemo");
+const TCHAR* const FImGuiModuleCommands::LogStats = TEXT("ImGui.Stats");
+const TCHAR* const FImGuiModuleCommands::DumpStatsJson = TEXT("ImGui.Stats.DumpJson");
+const TCHAR* const FImGuiModuleCommands::StartInputRecording = TEXT("ImGui.Input.StartRecording");
+const TCHAR* const FImGuiModuleCommands::StopInputRecording = TEXT("ImGui.Input.StopRecording");
+const TCHAR* const FImGuiModuleCommands::StartInputReplay = TEXT("ImGui.Input.StartReplay");
+const TCHAR* const FImGuiModuleCommands::StopInputReplay = TEXT("ImGui.Input.StopReplay");
 
-FImGuiModuleCommands::FImGuiModuleCommands(FImGuiModuleProperties& InProperties)
+FImGuiModuleCommands::FImGuiModuleCommands(FImGuiModuleProperties& InProperties, FImGuiContextManager& InContextManager)
 	: Properties(InProperties)
+	, ContextManager(InContextManager)
 	, ToggleInputCommand(ToggleInput,
 		TEXT("Toggle ImGui input mode."),
 		FConsoleCommandDelegate::CreateRaw(this, &FImGuiModuleCommands::ToggleInputImpl))
@@ -38,6 +74,27 @@ FImGuiModuleCommands::FImGuiModuleCommands(FImGuiModuleProperties& InProperties)
 	, ToggleDemoCommand(ToggleDemo,
 		TEXT("Toggle ImGui demo."),
 		FConsoleCommandDelegate::CreateRaw(this, &FImGuiModuleCommands::ToggleDemoImpl))
+	, LogStatsCommand(LogStats,
+		TEXT("Log timers and counters of all ImGui contexts from the last frame."),
+		FConsoleCommandDelegate::CreateRaw(this, &FImGuiModuleCommands::LogStatsImpl))
+	, DumpStatsJsonCommand(DumpStatsJson,
+		TEXT("Write timers and counters of all ImGui contexts from the last frame to a JSON file.\n")
+		TEXT("Arguments: [FilePath] (default Saved/ImGui/Stats.json)"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FImGuiModuleCommands::DumpStatsJsonImpl))
+	, StartInputRecordingCommand(StartInputRecording,
+		TEXT("Start recording input of all ImGui contexts."),
+		FConsoleCommandDelegate::CreateRaw(this, &FImGuiModuleCommands::StartInputRecordingImpl))
+	, StopInputRecordingCommand(StopInputRecording,
+		TEXT("Stop recording input and save it to one file per context, named after the context.\n")
+		TEXT("Arguments: [Directory] (default Saved/ImGui/Input)"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FImGuiModuleCommands::StopInputRecordingImpl))
+	, StartInputReplayCommand(StartInputReplay,
+		TEXT("Replay recorded input instead of live input in contexts that have input files.\n")
+		TEXT("Arguments: [Directory] (default Saved/ImGui/Input) [Loop]"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FImGuiModuleCommands::StartInputReplayImpl))
+	, StopInputReplayCommand(StopInputReplay,
+		TEXT("Stop replaying input and return to live input."),
+		FConsoleCommandDelegate::CreateRaw(this, &FImGuiModuleCommands::StopInputReplayImpl))
 {
 }
 
@@ -80,3 +137,166 @@ void FImGuiModuleCommands::ToggleDemoImpl()
 {
 	Properties.ToggleDemo();
 }
+
+void FImGuiModuleCommands::LogStatsImpl()
+{
+	using ETimer = FImGuiContextStats::ETimer;
+	using ECounter = FImGuiContextStats::ECounter;
+
+	ContextManager.ForEachContextProxy([](int32 ContextIndex, const FImGuiContextProxy& ContextProxy)
+	{
+		const FImGuiContextStats& Stats = ContextProxy.GetStats();
+
+		FString Timers;
+		for (int32 Timer = 0; Timer < static_cast<int32>(ETimer::Num); Timer++)
+		{
+			Timers += FString::Printf(TEXT(" %s=%.3fms"), FImGuiContextStats::GetName(static_cast<ETimer>(Timer)),
+				Stats.GetTime(static_cast<ETimer>(Timer)) * 1000.0);
+		}
+
+		FString Counters;
+		for (int32 Counter = 0; Counter < static_cast<int32>(ECounter::Num); Counter++)
+		{
+			Counters += FString::Printf(TEXT(" %s=%lld"), FImGuiContextStats::GetName(static_cast<ECounter>(Counter)),
+				Stats.GetCount(static_cast<ECounter>(Counter)));
+		}
+
+		UE_LOG(LogImGuiStats, Display, TEXT("%s (%d):%s%s"), *ContextProxy.GetName(), ContextIndex, *Timers, *Counters);
+	});
+
+	const ImFontAtlas& FontAtlas = ContextManager.GetFontAtlas();
+	const FImGuiDynamicFont& DynamicFont = ContextManager.GetDynamicFont();
+	UE_LOG(LogImGuiStats, Display, TEXT("Font atlas: %dx%d, dynamic glyphs: %d rasterized of %d."), FontAtlas.TexWidth,
+		FontAtlas.TexHeight, DynamicFont.GetNumRasterizedGlyphs(), DynamicFont.GetNumGlyphs());
+
+	// Only the CPU copy of atlas pixels is reduced. Requesting RGBA32 data makes ImGui keep them together with alpha
+	// data, so savings are compared to both. The texture is still created in PF_B8G8R8A8 format, because Slate samples
+	// single-channel formats as black or opaque grey, so its GPU memory is not affected.
+	const int64 NumPixels = static_cast<int64>(FontAtlas.TexWidth) * FontAtlas.TexHeight;
+	const int64 PixelBytes = (FontAtlas.TexPixelsAlpha8 ? NumPixels : 0) + (FontAtlas.TexPixelsRGBA32 ? NumPixels * 4 : 0);
+	UE_LOG(LogImGuiStats, Display, TEXT("Font atlas pixel data: %lld KB in CPU memory, %lld KB less than with RGBA32 data."),
+		PixelBytes / 1024, FMath::Max(NumPixels * 5 - PixelBytes, int64{ 0 }) / 1024);
+	UE_LOG(LogImGuiStats, Display, TEXT("Font atlas texture: %lld KB in GPU memory (B8G8R8A8)."), NumPixels * 4 / 1024);
+}
+
+void FImGuiModuleCommands::DumpStatsJsonImpl(const TArray<FString>& Args)
+{
+	using ETimer = FImGuiContextStats::ETimer;
+	using ECounter = FImGuiContextStats::ECounter;
+
+	const FString FilePath = Args.Num() > 0 ? Args[0] : FPaths::Combine(*GetSavedDir(), TEXT("Stats.json"));
+
+	TArray<TSharedPtr<FJsonValue>> Contexts;
+	ContextManager.ForEachContextProxy([&Contexts](int32 ContextIndex, const FImGuiContextProxy& ContextProxy)
+	{
+		const FImGuiContextStats& Stats = ContextProxy.GetStats();
+
+		TSharedRef<FJsonObject> Timers = MakeShared<FJsonObject>();
+		for (int32 Timer = 0; Timer < static_cast<int32>(ETimer::Num); Timer++)
+		{
+			Timers->SetNumberField(FImGuiContextStats::GetName(static_cast<ETimer>(Timer)),
+				Stats.GetTime(static_cast<ETimer>(Timer)) * 1000.0);
+		}
+
+		TSharedRef<FJsonObject> Counters = MakeShared<FJsonObject>();
+		for (int32 Counter = 0; Counter < static_cast<int32>(ECounter::Num); Counter++)
+		{
+			Counters->SetNumberField(FImGuiContextStats::GetName(static_cast<ECounter>(Counter)),
+				static_cast<double>(Stats.GetCount(static_cast<ECounter>(Counter))));
+		}
+
+		TSharedRef<FJsonObject> Context = MakeShared<FJsonObject>();
+		Context->SetStringField(TEXT("Name"), ContextProxy.GetName());
+		Context->SetNumberField(TEXT("Index"), ContextIndex);
+		Context->SetObjectField(TEXT("TimersMs"), Timers);
+		Context->SetObjectField(TEXT("Counters"), Counters);
+		Contexts.Add(MakeShared<FJsonValueObject>(Context));
+	});
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("Frame"), GFrameNumber);
+	Root->SetArrayField(TEXT("Contexts"), Contexts);
+
+	FString Json;
+	FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+
+	if (FFileHelper::SaveStringToFile(Json, *FilePath))
+	{
+		UE_LOG(LogImGuiStats, Display, TEXT("ImGui stats written to '%s'."), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogImGuiStats, Error, TEXT("Failed to write ImGui stats to '%s'."), *FilePath);
+	}
+}
+
+void FImGuiModuleCommands::StartInputRecordingImpl()
+{
+	ContextManager.ForEachContextProxy([](int32 ContextIndex, FImGuiContextProxy& ContextProxy)
+	{
+		ContextProxy.StartInputRecording();
+	});
+
+	UE_LOG(LogImGuiInput, Display, TEXT("ImGui input recording started."));
+}
+
+void FImGuiModuleCommands::StopInputRecordingImpl(const TArray<FString>& Args)
+{
+	const FString Directory = Args.Num() > 0 ? Args[0] : FPaths::Combine(*GetSavedDir(), TEXT("Input"));
+
+	ContextManager.ForEachContextProxy([&Directory](int32 ContextIndex, FImGuiContextProxy& ContextProxy)
+	{
+		FImGuiInputStream Stream;
+		if (ContextProxy.StopInputRecording(Stream))
+		{
+			const FString FilePath = GetInputFile(Directory, ContextProxy);
+			if (Stream.Save(FilePath))
+			{
+				UE_LOG(LogImGuiInput, Display, TEXT("Input of '%s' written to '%s': %d frames, %d bytes."),
+					*ContextProxy.GetName(), *FilePath, Stream.GetNumFrames(), Stream.GetNumBytes());
+			}
+			else
+			{
+				UE_LOG(LogImGuiInput, Error, TEXT("Failed to write input of '%s' to '%s'."), *ContextProxy.GetName(), *FilePath);
+			}
+		}
+	});
+}
+
+void FImGuiModuleCommands::StartInputReplayImpl(const TArray<FString>& Args)
+{
+	FString Directory = FPaths::Combine(*GetSavedDir(), TEXT("Input"));
+	bool bLoop = false;
+	for (const FString& Arg : Args)
+	{
+		if (Arg.Equals(TEXT("Loop"), ESearchCase::IgnoreCase))
+		{
+			bLoop = true;
+		}
+		else
+		{
+			Directory = Arg;
+		}
+	}
+
+	ContextManager.ForEachContextProxy([&Directory, bLoop](int32 ContextIndex, FImGuiContextProxy& ContextProxy)
+	{
+		const FString FilePath = GetInputFile(Directory, ContextProxy);
+
+		FImGuiInputStream Stream;
+		if (Stream.Load(FilePath) && Stream.GetNumFrames() > 0)
+		{
+			ContextProxy.StartInputReplay(Stream, bLoop);
+			UE_LOG(LogImGuiInput, Display, TEXT("Replaying input of '%s' from '%s': %d frames."), *ContextProxy.GetName(),
+				*FilePath, Stream.GetNumFrames());
+		}
+	});
+}
+
+void FImGuiModuleCommands::StopInputReplayImpl()
+{
+	ContextManager.ForEachContextProxy([](int32 ContextIndex, FImGuiContextProxy& ContextProxy)
+	{
+		ContextProxy.StopInputReplay();
+	});
+}
@@ -6,6 +6,7 @@
 
 
 struct FImGuiKeyInfo;
+class FImGuiContextManager;
 class FImGuiModuleProperties;
 
 // Manges ImGui module console commands.
@@ -20,8 +21,14 @@ public:
 	static const TCHAR* const ToggleGamepadInputSharing;
 	static const TCHAR* const ToggleMouseInputSharing;
 	static const TCHAR* const ToggleDemo;
+	static const TCHAR* const LogStats;
+	static const TCHAR* const DumpStatsJson;
+	static const TCHAR* const StartInputRecording;
+	static const TCHAR* const StopInputRecording;
+	static const TCHAR* const StartInputReplay;
+	static const TCHAR* const StopInputReplay;
 
-	FImGuiModuleCommands(FImGuiModuleProperties& InProperties);
+	FImGuiModuleCommands(FImGuiModuleProperties& InProperties, FImGuiContextManager& InContextManager);
 
 	void SetKeyBinding(const TCHAR* CommandName, const FImGuiKeyInfo& KeyInfo);
 
@@ -34,8 +41,15 @@ private:
 	void ToggleGamepadInputSharingImpl();
 	void ToggleMouseInputSharingImpl();
 	void ToggleDemoImpl();
+	void LogStatsImpl();
+	void DumpStatsJsonImpl(const TArray<FString>& Args);
+	void StartInputRecordingImpl();
+	void StopInputRecordingImpl(const TArray<FString>& Args);
+	void StartInputReplayImpl(const TArray<FString>& Args);
+	void StopInputReplayImpl();
 
 	FImGuiModuleProperties& Properties;
+	FImGuiContextManager& ContextManager;
 
 	FAutoConsoleCommand ToggleInputCommand;
 	FAutoConsoleCommand ToggleKeyboardNavigationCommand;
@@ -44,4 +58,10 @@ private:
 	FAutoConsoleCommand ToggleGamepadInputSharingCommand;
 	FAutoConsoleCommand ToggleMouseInputSharingCommand;
 	FAutoConsoleCommand ToggleDemoCommand;
+	FAutoConsoleCommand LogStatsCommand;
+	FAutoConsoleCommand DumpStatsJsonCommand;
+	FAutoConsoleCommand StartInputRecordingCommand;
+	FAutoConsoleCommand StopInputRecordingCommand;
+	FAutoConsoleCommand StartInputReplayCommand;
+	FAutoConsoleCommand StopInputReplayCommand;
 };
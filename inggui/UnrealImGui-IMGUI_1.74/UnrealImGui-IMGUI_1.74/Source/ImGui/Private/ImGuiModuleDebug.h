@@ -3,6 +3,7 @@
 #pragma once
 
 #include <Logging/LogMacros.h>
+#include <Stats/Stats.h>
 
 
 // Module-wide debug symbols and loggers.
@@ -14,3 +15,7 @@
 
 // Input Handler logger (used also in non-developer mode to raise problems with handler extensions).
 DECLARE_LOG_CATEGORY_EXTERN(LogImGuiInputHandler, Warning, All);
+
+
+// Stats group for ImGui contexts and rendering (see 'stat ImGui').
+DECLARE_STATS_GROUP(TEXT("ImGui"), STATGROUP_ImGui, STATCAT_Advanced);
@@ -17,13 +17,16 @@ constexpr int32 IMGUI_WIDGET_Z_ORDER = 10000;
 
 
 FImGuiModuleManager::FImGuiModuleManager()
-	: Commands(Properties)
+	: Commands(Properties, ContextManager)
 	, Settings(Properties, Commands)
 	, ImGuiDemo(Properties)
 {
 	// Register in context manager to get information whenever a new context proxy is created.
 	ContextManager.OnContextProxyCreated().AddRaw(this, &FImGuiModuleManager::OnContextProxyCreated);
 
+	// Register in context manager to update the font atlas texture when glyphs are added.
+	ContextManager.OnFontAtlasUpdated().AddRaw(this, &FImGuiModuleManager::OnFontAtlasUpdated);
+
 	// Typically we will use viewport created events to add widget to new game viewports.
 	ViewportCreatedHandle = UGameViewportClient::OnViewportCreated().AddRaw(this, &FImGuiModuleManager::OnViewportCreated);
 
@@ -82,18 +85,23 @@ void FImGuiModuleManager::LoadTextures()
 		// Create an empty texture at index 0. We will use it for ImGui outputs with null texture id.
 		TextureManager.CreatePlainTexture(FName{ "ImGuiModule_Plain" }, 2, 2, FColor::White);
 
-		// Create a font atlas texture.
-		ImFontAtlas& Fonts = ContextManager.GetFontAtlas();
+		// Create a font atlas texture and set its index in ImGui.
+		ContextManager.GetFontAtlas().TexID = ImGuiInterops::ToImTextureID(CreateFontAtlasTexture());
+	}
+}
 
-		unsigned char* Pixels;
-		int Width, Height, Bpp;
-		Fonts.GetTexDataAsRGBA32(&Pixels, &Width, &Height, &Bpp);
+TextureIndex FImGuiModuleManager::CreateFontAtlasTexture()
+{
+	ImFontAtlas& Fonts = ContextManager.GetFontAtlas();
 
-		TextureIndex FontsTexureIndex = TextureManager.CreateTexture(FName{ "ImGuiModule_FontAtlas" }, Width, Height, Bpp, Pixels);
+	// Atlas keeps only alpha data, which are expanded to white pixels in a temporary copy for upload.
+	unsigned char* Pixels;
+	int Width, Height;
+	Fonts.GetTexDataAsAlpha8(&Pixels, &Width, &Height);
 
-		// Set font texture index in ImGui.
-		Fonts.TexID = ImGuiInterops::ToImTextureID(FontsTexureIndex);
-	}
+	// Replaced textures are released with a delay, so every texture needs a unique name.
+	const FName Name{ "ImGuiModule_FontAtlas", FontAtlasTextureNumber++ };
+	return TextureManager.CreateTextureFromAlpha(Name, Width, Height, Pixels);
 }
 
 void FImGuiModuleManager::RegisterTick()
@@ -151,9 +159,31 @@ void FImGuiModuleManager::Tick(float DeltaSeconds)
 {
 	if (IsInGameThread())
 	{
+		// Release replaced font atlas textures, once all draw data that used them were drawn.
+		for (int32 Index = ReplacedFontAtlasTextures.Num() - 1; Index >= 0; Index--)
+		{
+			if (--ReplacedFontAtlasTextures[Index].Value == 0)
+			{
+				TextureManager.ReleaseTextureResources(ReplacedFontAtlasTextures[Index].Key);
+				ReplacedFontAtlasTextures.RemoveAtSwap(Index, 1, false);
+			}
+		}
+
 		// Update context manager to advance all ImGui contexts to the next frame.
 		ContextManager.Tick(DeltaSeconds);
 
+		// Send texture updates from this frame to the render thread.
+		TextureManager.FlushTextureUpdates();
+
+		// Repacking the texture atlas moves textures, so cached windows need to be rebuilt with new coordinates.
+		if (TextureManager.RepackAtlas())
+		{
+			ContextManager.ForEachContextProxy([](int32 ContextIndex, FImGuiContextProxy& ContextProxy)
+			{
+				ContextProxy.GetWindowCache().InvalidateAll();
+			});
+		}
+
 		// Inform that we finished updating ImGui, so other subsystems can react.
 		PostImGuiUpdateEvent.Broadcast();
 	}
@@ -220,3 +250,28 @@ void FImGuiModuleManager::OnContextProxyCreated(int32 ContextIndex, FImGuiContex
 {
 	ContextProxy.OnDraw().AddLambda([this, ContextIndex]() { ImGuiDemo.DrawControls(ContextIndex); });
 }
+
+void FImGuiModuleManager::OnFontAtlasUpdated(const FIntRect& DirtyRect, bool bResized)
+{
+	// Textures loaded later are created from the current atlas data.
+	if (!bTexturesLoaded)
+	{
+		return;
+	}
+
+	ImFontAtlas& Fonts = ContextManager.GetFontAtlas();
+	const TextureIndex FontsTextureIndex = ImGuiInterops::ToTextureIndex(Fonts.TexID);
+
+	if (bResized)
+	{
+		// Draw data from this frame still use the old texture and texture coordinates. They can be drawn after the next
+		// tick, when draw data are pipelined, so the old texture is released only in the tick after that.
+		ReplacedFontAtlasTextures.Emplace(FontsTextureIndex, 2);
+		Fonts.TexID = ImGuiInterops::ToImTextureID(CreateFontAtlasTexture());
+	}
+	else
+	{
+		TextureManager.UpdateTextureRegionsFromAlpha(FontsTextureIndex, MakeArrayView(&DirtyRect, 1), Fonts.TexPixelsAlpha8,
+			Fonts.TexWidth);
+	}
+}
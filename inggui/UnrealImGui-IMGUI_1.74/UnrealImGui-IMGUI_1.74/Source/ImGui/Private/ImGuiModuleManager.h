@@ -46,6 +46,7 @@ private:
 	FImGuiModuleManager& operator=(FImGuiModuleManager&&) = delete;
 
 	void LoadTextures();
+	TextureIndex CreateFontAtlasTexture();
 
 	bool IsTickRegistered() { return TickDelegateHandle.IsValid(); }
 	void RegisterTick();
@@ -63,6 +64,8 @@ private:
 
 	void OnContextProxyCreated(int32 ContextIndex, FImGuiContextProxy& ContextProxy);
 
+	void OnFontAtlasUpdated(const FIntRect& DirtyRect, bool bResized);
+
 	// Event that we call after ImGui is updated.
 	FSimpleMulticastDelegate PostImGuiUpdateEvent;
 
@@ -91,5 +94,11 @@ private:
 	FDelegateHandle TickDelegateHandle;
 	FDelegateHandle ViewportCreatedHandle;
 
+	// Font atlas textures replaced in recent ticks, with the number of ticks for which they still need to be kept.
+	// Draw data from the frame in which the texture was replaced still use it and with pipelined draw data, they are
+	// drawn only after the next tick.
+	TArray<TPair<TextureIndex, int32>, TInlineAllocator<2>> ReplacedFontAtlasTextures;
+	int32 FontAtlasTextureNumber = 0;
+
 	bool bTexturesLoaded = false;
 };
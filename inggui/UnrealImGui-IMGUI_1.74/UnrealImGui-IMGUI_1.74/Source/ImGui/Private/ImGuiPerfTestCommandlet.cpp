@@ -0,0 +1,409 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiPerfTestCommandlet.h"
+
+#include "ImGuiContextProxy.h"
+#include "ImGuiImplementation.h"
+#include "ImGuiInputStream.h"
+#include "ImGuiInteroperability.h"
+#include "Utilities/WorldContextIndex.h"
+
+#include <Dom/JsonObject.h>
+#include <Misc/FileHelper.h>
+#include <Serialization/JsonSerializer.h>
+
+#include <imgui.h>
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiPerfTest, Log, All);
+
+namespace
+{
+	// Values measured in every frame, summed over all contexts.
+	enum class EMetric : uint8
+	{
+		FrameTime,
+		Input,
+		DrawEvents,
+		NewFrame,
+		Render,
+		Transfer,
+		Conversion,
+		DrawCommands,
+		CulledDrawCommands,
+		Vertices,
+		Allocations,
+
+		Num
+	};
+
+	const TCHAR* GetName(EMetric Metric)
+	{
+		switch (Metric)
+		{
+		case EMetric::FrameTime: return TEXT("FrameTimeMs");
+		case EMetric::Input: return TEXT("InputMs");
+		case EMetric::DrawEvents: return TEXT("DrawEventsMs");
+		case EMetric::NewFrame: return TEXT("NewFrameMs");
+		case EMetric::Render: return TEXT("RenderMs");
+		case EMetric::Transfer: return TEXT("TransferMs");
+		case EMetric::Conversion: return TEXT("ConversionMs");
+		case EMetric::DrawCommands: return TEXT("DrawCommands");
+		case EMetric::CulledDrawCommands: return TEXT("CulledDrawCommands");
+		case EMetric::Vertices: return TEXT("Vertices");
+		case EMetric::Allocations: return TEXT("Allocations");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	// Generate input that moves the mouse across the canvas, clicks, scrolls and types, so windows are hovered,
+	// dragged and resized like in an interactive session.
+	void GenerateInput(FImGuiInputStream& Stream, int32 NumFrames)
+	{
+		const uint32 LeftMouseIndex = ImGuiInterops::GetMouseIndex(EKeys::LeftMouseButton);
+
+		for (int32 Frame = 0; Frame < NumFrames; Frame++)
+		{
+			Stream.AddFrame(1.f / 60.f);
+
+			const float Time = Frame / 60.f;
+			Stream.AddMousePosition({ 960.f + 800.f * FMath::Sin(Time * 0.7f), 540.f + 450.f * FMath::Sin(Time * 1.1f) });
+
+			switch (Frame % 60)
+			{
+			case 0:
+				Stream.AddMouseButton(LeftMouseIndex, true);
+				break;
+			case 20:
+				Stream.AddMouseButton(LeftMouseIndex, false);
+				break;
+			case 30:
+				Stream.AddMouseWheelDelta(-1.f);
+				break;
+			case 40:
+				Stream.AddCharacter(TEXT('a') + (Frame / 60) % 26);
+				break;
+			}
+		}
+	}
+
+	// State of test windows in one context.
+	struct FTestWindowsState
+	{
+		static constexpr int32 NumValues = 128;
+		float Values[NumValues] = {};
+		TArray<float> Sliders;
+	};
+
+	// Windows with widgets typical for debug tools: text, sliders, plots, trees and long lists.
+	void DrawTestWindows(FTestWindowsState& State)
+	{
+		constexpr int32 NumValues = FTestWindowsState::NumValues;
+		float* Values = State.Values;
+		for (int32 Index = 0; Index < NumValues; Index++)
+		{
+			Values[Index] = FMath::Sin(Index * 0.1f + GFrameNumber * 0.05f);
+		}
+
+		for (int32 WindowIndex = 0; WindowIndex < State.Sliders.Num(); WindowIndex++)
+		{
+			ImGui::SetNextWindowPos(ImVec2(40.f + 60.f * WindowIndex, 40.f + 40.f * WindowIndex), ImGuiCond_FirstUseEver);
+			ImGui::SetNextWindowSize(ImVec2(420.f, 360.f), ImGuiCond_FirstUseEver);
+
+			if (ImGui::Begin(TCHAR_TO_UTF8(*FString::Printf(TEXT("Tool %d"), WindowIndex))))
+			{
+				ImGui::Text("Frame %u, window %d", GFrameNumber, WindowIndex);
+				ImGui::SliderFloat("Value", &State.Sliders[WindowIndex], 0.f, 1.f);
+				ImGui::PlotLines("Signal", Values, NumValues, 0, nullptr, -1.f, 1.f, ImVec2(0.f, 60.f));
+
+				if (ImGui::TreeNode("Properties"))
+				{
+					for (int32 Index = 0; Index < 16; Index++)
+					{
+						ImGui::Text("Property %d: %.3f", Index, Values[Index]);
+					}
+					ImGui::TreePop();
+				}
+
+				ImGui::BeginChild("List", ImVec2(0.f, 0.f), true);
+				for (int32 Index = 0; Index < 200; Index++)
+				{
+					ImGui::PushID(Index);
+					ImGui::Selectable("Entry", false);
+					ImGui::SameLine();
+					ImGui::Text("%d", Index);
+					ImGui::PopID();
+				}
+				ImGui::EndChild();
+			}
+			ImGui::End();
+		}
+	}
+
+	struct FPercentiles
+	{
+		double Average = 0.0;
+		double Median = 0.0;
+		double P95 = 0.0;
+		double Max = 0.0;
+	};
+
+	FPercentiles CalculatePercentiles(TArray<double> Values)
+	{
+		FPercentiles Result;
+		if (Values.Num() > 0)
+		{
+			Values.Sort();
+			for (double Value : Values)
+			{
+				Result.Average += Value;
+			}
+			Result.Average /= Values.Num();
+			Result.Median = Values[Values.Num() / 2];
+			Result.P95 = Values[FMath::Min(Values.Num() * 95 / 100, Values.Num() - 1)];
+			Result.Max = Values.Last();
+		}
+		return Result;
+	}
+}
+
+UImGuiPerfTestCommandlet::UImGuiPerfTestCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UImGuiPerfTestCommandlet::Main(const FString& Params)
+{
+	int32 NumContexts = 1;
+	int32 NumFrames = 600;
+	int32 NumWindows = 8;
+	FString InputFile;
+	FString ReportFile;
+
+	FParse::Value(*Params, TEXT("Contexts="), NumContexts);
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+	FParse::Value(*Params, TEXT("Windows="), NumWindows);
+	FParse::Value(*Params, TEXT("Input="), InputFile);
+	FParse::Value(*Params, TEXT("Report="), ReportFile);
+
+	NumContexts = FMath::Max(NumContexts, 1);
+	NumFrames = FMath::Max(NumFrames, 1);
+	NumWindows = FMath::Max(NumWindows, 0);
+
+	const bool bCheckAllocations = FParse::Param(*Params, TEXT("CheckAllocations"));
+
+	FImGuiInputStream Input;
+	if (InputFile.IsEmpty())
+	{
+		GenerateInput(Input, NumFrames);
+	}
+	else if (!Input.Load(InputFile) || Input.GetNumFrames() == 0)
+	{
+		UE_LOG(LogImGuiPerfTest, Error, TEXT("Failed to load input stream '%s'."), *InputFile);
+		return 1;
+	}
+
+	// Context switches stay local to this scope, so the module's current context is not affected.
+	ImGuiImplementation::FScopedThreadContext ThreadContext;
+
+	// Only the alpha data are built. Without a texture manager, draw commands keep the null texture id, which doesn't
+	// matter for the cost of frames.
+	ImFontAtlas FontAtlas;
+	{
+		unsigned char* Pixels;
+		int Width, Height;
+		FontAtlas.GetTexDataAsAlpha8(&Pixels, &Width, &Height);
+	}
+
+	// Test contexts don't have world indices, so they don't call world debug delegates registered in the module. Each
+	// context draws from its own state, so nothing is shared between contexts.
+	FSimpleMulticastDelegate SharedDrawEvent;
+
+	TArray<FTestWindowsState> TestWindowsStates;
+	TestWindowsStates.SetNum(NumContexts);
+
+	TArray<TUniquePtr<FImGuiContextProxy>> ContextProxies;
+	for (int32 ContextIndex = 0; ContextIndex < NumContexts; ContextIndex++)
+	{
+		ContextProxies.Emplace(MakeUnique<FImGuiContextProxy>(FString::Printf(TEXT("PerfTest%d"), ContextIndex),
+			Utilities::INVALID_CONTEXT_INDEX, &SharedDrawEvent, &FontAtlas));
+
+		FTestWindowsState* State = &TestWindowsStates[ContextIndex];
+		State->Sliders.Init(0.5f, NumWindows);
+		ContextProxies.Last()->OnDraw().AddLambda([State]() { DrawTestWindows(*State); });
+	}
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	// Contexts have a 4K canvas, of which a Full HD widget shows only a part, like in a game viewport.
+	const FSlateRect CullingRect{ 0.f, 0.f, 1920.f, 1080.f };
+
+	TArray<FImGuiSlateDrawData> SlateDrawData;
+	SlateDrawData.SetNum(NumContexts);
+#endif
+
+	TArray<double> Metrics[static_cast<int32>(EMetric::Num)];
+	for (TArray<double>& Values : Metrics)
+	{
+		Values.Reserve(NumFrames);
+	}
+
+	using ETimer = FImGuiContextStats::ETimer;
+	using ECounter = FImGuiContextStats::ECounter;
+
+	// Tick all contexts once, applying input from the given frame, if any.
+	auto TickContexts = [&](int32 InputFrame, float DeltaSeconds)
+	{
+		// Proxies tick once per engine frame and stats are collected per engine frame, but commandlets don't tick the
+		// engine.
+		GFrameNumber++;
+
+		for (int32 ContextIndex = 0; ContextIndex < NumContexts; ContextIndex++)
+		{
+			FImGuiContextProxy& ContextProxy = *ContextProxies[ContextIndex];
+			if (InputFrame != INDEX_NONE)
+			{
+				Input.Apply(InputFrame, ContextProxy.GetInputState());
+			}
+			ContextProxy.Tick(DeltaSeconds);
+
+#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+			// Conversion to Slate vertices doesn't need rendering, so it is measured like in widgets.
+			FImGuiSlateDrawData& DrawData = SlateDrawData[ContextIndex];
+			DrawData.Prepare(ContextProxy.GetDrawData(), FSlateRenderTransform{}, CullingRect);
+			ContextProxy.GetStats().AddTime(ETimer::Conversion, DrawData.PrepareTime);
+			ContextProxy.GetStats().AddCount(ECounter::BytesConverted, DrawData.NumBytesConverted);
+			ContextProxy.GetStats().AddCount(ECounter::CulledDrawCommands, DrawData.NumCulledCommands);
+#endif
+		}
+	};
+
+	for (int32 Frame = 0; Frame < NumFrames; Frame++)
+	{
+		const int32 InputFrame = Frame % Input.GetNumFrames();
+		const double StartTime = FPlatformTime::Seconds();
+
+		TickContexts(InputFrame, Input.GetDeltaSeconds(InputFrame));
+
+		Metrics[static_cast<int32>(EMetric::FrameTime)].Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+		double Times[static_cast<int32>(EMetric::Num)] = {};
+		for (const TUniquePtr<FImGuiContextProxy>& ContextProxy : ContextProxies)
+		{
+			const FImGuiContextStats& Stats = ContextProxy->GetStats();
+			Times[static_cast<int32>(EMetric::Input)] += Stats.GetTime(ETimer::Input) * 1000.0;
+			Times[static_cast<int32>(EMetric::DrawEvents)] += Stats.GetTime(ETimer::DrawEvents) * 1000.0;
+			Times[static_cast<int32>(EMetric::NewFrame)] += Stats.GetTime(ETimer::NewFrame) * 1000.0;
+			Times[static_cast<int32>(EMetric::Render)] += Stats.GetTime(ETimer::Render) * 1000.0;
+			Times[static_cast<int32>(EMetric::Transfer)] += Stats.GetTime(ETimer::Transfer) * 1000.0;
+			Times[static_cast<int32>(EMetric::Conversion)] += Stats.GetTime(ETimer::Conversion) * 1000.0;
+			Times[static_cast<int32>(EMetric::DrawCommands)] += Stats.GetCount(ECounter::DrawCommands);
+			Times[static_cast<int32>(EMetric::CulledDrawCommands)] += Stats.GetCount(ECounter::CulledDrawCommands);
+			Times[static_cast<int32>(EMetric::Vertices)] += Stats.GetCount(ECounter::Vertices);
+			Times[static_cast<int32>(EMetric::Allocations)] += Stats.GetCount(ECounter::Allocations);
+		}
+
+		for (int32 Metric = static_cast<int32>(EMetric::Input); Metric < static_cast<int32>(EMetric::Num); Metric++)
+		{
+			Metrics[Metric].Add(Times[Metric]);
+		}
+	}
+
+	UE_LOG(LogImGuiPerfTest, Display, TEXT("%d frames, %d contexts, %d windows, input: %s."), NumFrames, NumContexts, NumWindows,
+		InputFile.IsEmpty() ? TEXT("generated") : *InputFile);
+
+	TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+	for (int32 Metric = 0; Metric < static_cast<int32>(EMetric::Num); Metric++)
+	{
+		const FPercentiles Percentiles = CalculatePercentiles(Metrics[Metric]);
+		UE_LOG(LogImGuiPerfTest, Display, TEXT("%-14s avg %10.3f  median %10.3f  p95 %10.3f  max %10.3f"), GetName(static_cast<EMetric>(Metric)),
+			Percentiles.Average, Percentiles.Median, Percentiles.P95, Percentiles.Max);
+
+		TSharedRef<FJsonObject> Values = MakeShared<FJsonObject>();
+		Values->SetNumberField(TEXT("Average"), Percentiles.Average);
+		Values->SetNumberField(TEXT("Median"), Percentiles.Median);
+		Values->SetNumberField(TEXT("P95"), Percentiles.P95);
+		Values->SetNumberField(TEXT("Max"), Percentiles.Max);
+		Summary->SetObjectField(GetName(static_cast<EMetric>(Metric)), Values);
+	}
+
+	if (!ReportFile.IsEmpty())
+	{
+		TArray<TSharedPtr<FJsonValue>> FrameTimes;
+		for (double Value : Metrics[static_cast<int32>(EMetric::FrameTime)])
+		{
+			FrameTimes.Add(MakeShared<FJsonValueNumber>(Value));
+		}
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetNumberField(TEXT("Frames"), NumFrames);
+		Root->SetNumberField(TEXT("Contexts"), NumContexts);
+		Root->SetNumberField(TEXT("Windows"), NumWindows);
+		Root->SetObjectField(TEXT("Summary"), Summary);
+		Root->SetArrayField(TEXT("FrameTimesMs"), FrameTimes);
+
+		FString Json;
+		FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+
+		if (!FFileHelper::SaveStringToFile(Json, *ReportFile))
+		{
+			UE_LOG(LogImGuiPerfTest, Error, TEXT("Failed to write report to '%s'."), *ReportFile);
+			return 1;
+		}
+
+		UE_LOG(LogImGuiPerfTest, Display, TEXT("Report written to '%s'."), *ReportFile);
+	}
+
+	if (bCheckAllocations)
+	{
+		constexpr int32 NumWarmUpFrames = 60;
+		constexpr int32 NumCheckedFrames = 120;
+
+		// Release keys and buttons held at the end of input, so the content can settle.
+		for (const TUniquePtr<FImGuiContextProxy>& ContextProxy : ContextProxies)
+		{
+			ContextProxy->GetInputState().Reset();
+		}
+
+		for (int32 Frame = 0; Frame < NumWarmUpFrames; Frame++)
+		{
+			TickContexts(INDEX_NONE, 1.f / 60.f);
+		}
+
+		int32 NumAllocatingFrames = 0;
+		for (int32 Frame = 0; Frame < NumCheckedFrames; Frame++)
+		{
+			const uint32 BufferGrowthsBefore = ImGuiDrawDataCounters::GetNumBufferGrowths();
+			TickContexts(INDEX_NONE, 1.f / 60.f);
+
+			int64 NumAllocations = 0;
+			for (const TUniquePtr<FImGuiContextProxy>& ContextProxy : ContextProxies)
+			{
+				NumAllocations += ContextProxy->GetStats().GetCount(ECounter::Allocations);
+			}
+			const uint32 NumBufferGrowths = ImGuiDrawDataCounters::GetNumBufferGrowths() - BufferGrowthsBefore;
+
+			if (NumAllocations > 0 || NumBufferGrowths > 0)
+			{
+				NumAllocatingFrames++;
+				UE_LOG(LogImGuiPerfTest, Display, TEXT("Steady-state frame %d: %lld ImGui allocations, %u draw data buffer growths."),
+					Frame, NumAllocations, NumBufferGrowths);
+			}
+		}
+
+		if (NumAllocatingFrames > 0)
+		{
+			UE_LOG(LogImGuiPerfTest, Error, TEXT("%d of %d steady-state frames allocated ImGui memory or grew draw data buffers."),
+				NumAllocatingFrames, NumCheckedFrames);
+			return 1;
+		}
+
+		UE_LOG(LogImGuiPerfTest, Display, TEXT("No allocations in %d steady-state frames."), NumCheckedFrames);
+	}
+
+	return 0;
+}
@@ -0,0 +1,33 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Commandlets/Commandlet.h>
+
+#include "ImGuiPerfTestCommandlet.generated.h"
+
+
+// Runs ImGui contexts without Slate, textures or rendering, and reports the cost of their frames. It is meant for
+// automated performance tests and can run on machines without GPU:
+//
+//   UE4Editor-Cmd <Project> -run=ImGuiPerfTest -nullrhi [-Contexts=1] [-Frames=600] [-Windows=8] [-Input=<File>]
+//       [-Report=<File>] [-CheckAllocations]
+//
+// Contexts draw a number of windows with common widgets, whose state is kept per context, so contexts don't affect each
+// other (the ImGui demo window is not used, because it keeps its state in statics). Input is replayed from a stream
+// file (see FImGuiInputStream) or, if none is given, from generated mouse, wheel and keyboard input. Per-frame timings
+// and vertex, command and allocation counts are logged as averages and percentiles, and can be written to a JSON report.
+//
+// With -CheckAllocations, contexts keep running without input after measured frames and the commandlet fails if, once
+// warmed up, any frame allocates ImGui memory or grows draw data buffers.
+UCLASS()
+class UImGuiPerfTestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UImGuiPerfTestCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
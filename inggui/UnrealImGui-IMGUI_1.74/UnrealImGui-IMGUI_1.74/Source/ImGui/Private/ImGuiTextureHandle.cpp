@@ -22,5 +22,5 @@ FImGuiTextureHandle::FImGuiTextureHandle(const FName& InName, ImTextureID InText
 		TEXT(" Name = '%s', TextureIndex(TextureId) = %d"), *Name.ToString(), Index);
 }
 
-// FImGuiTextureHandle::HasValidEntry() is implemented in ImGuiModule.cpp to get access to FImGuiModuleManager instance
+// FImGuiTextureHandle::HasValidEntry(), GetUV0() and GetUV1() are implemented in ImGuiModule.cpp to get access to FImGuiModuleManager instance
 // without referencing in this class.
@@ -0,0 +1,190 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiWindowCache.h"
+
+#include "ImGuiImplementation.h"
+
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cached Window Hits"), STAT_ImGuiCachedWindowHits, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cached Window Misses"), STAT_ImGuiCachedWindowMisses, STATGROUP_ImGui);
+
+
+namespace
+{
+	FORCEINLINE ImVec2 Translate(const ImVec2& Point, const ImVec2& Offset)
+	{
+		return { Point.x + Offset.x, Point.y + Offset.y };
+	}
+
+	FORCEINLINE ImVec2 Relative(const ImVec2& Point, const ImVec2& Origin)
+	{
+		return { Point.x - Origin.x, Point.y - Origin.y };
+	}
+
+	FORCEINLINE bool AreEqual(const ImVec2& Lhs, const ImVec2& Rhs)
+	{
+		return Lhs.x == Rhs.x && Lhs.y == Rhs.y;
+	}
+}
+
+bool FImGuiWindowCache::Begin(const char* Name, uint32 ContentVersion, bool* bOpen, ImGuiWindowFlags Flags)
+{
+	FActiveWindow& Active = ActiveWindows.AddDefaulted_GetRef();
+	Active.WindowId = ImGuiImplementation::GetWindowId(Name);
+
+	if (!ImGui::Begin(Name, bOpen, Flags))
+	{
+		// Collapsed or clipped window doesn't need content.
+		return false;
+	}
+
+	FCachedWindow& Window = Windows.FindOrAdd(Active.WindowId);
+	Active.Origin = ImGui::GetCursorScreenPos();
+
+	// Content can be culled by ImGui depending on window size and scroll, so cached output is valid only as long as
+	// those don't change.
+	const ImVec2 WindowSize = ImGui::GetWindowSize();
+	const ImVec2 Scroll{ ImGui::GetScrollX(), ImGui::GetScrollY() };
+
+	if (Window.bValid && Window.ContentVersion == ContentVersion && AreEqual(Window.WindowSize, WindowSize) && AreEqual(Window.Scroll, Scroll))
+	{
+		NumHits++;
+		INC_DWORD_STAT(STAT_ImGuiCachedWindowHits);
+
+		Emit(Window, Active.Origin);
+		return false;
+	}
+
+	NumMisses++;
+	INC_DWORD_STAT(STAT_ImGuiCachedWindowMisses);
+
+	Window.ContentVersion = ContentVersion;
+	Window.WindowSize = WindowSize;
+	Window.Scroll = Scroll;
+
+	// Mark the beginning of content in the draw list, so we can capture it in End.
+	const ImDrawList* DrawList = ImGui::GetWindowDrawList();
+	Active.VertexStart = DrawList->VtxBuffer.Size;
+	Active.IndexStart = DrawList->IdxBuffer.Size;
+	Active.bCapturing = true;
+
+	return true;
+}
+
+void FImGuiWindowCache::End()
+{
+	checkf(ActiveWindows.Num() > 0, TEXT("Cached window End called without matching Begin."));
+
+	const FActiveWindow Active = ActiveWindows.Pop();
+	if (Active.bCapturing)
+	{
+		if (FCachedWindow* Window = Windows.Find(Active.WindowId))
+		{
+			Capture(*Window, Active);
+		}
+	}
+
+	ImGui::End();
+}
+
+void FImGuiWindowCache::Invalidate(const char* Name)
+{
+	Invalidate(ImGuiImplementation::GetWindowId(Name));
+}
+
+void FImGuiWindowCache::Invalidate(ImGuiID WindowId)
+{
+	if (FCachedWindow* Window = Windows.Find(WindowId))
+	{
+		Window->bValid = false;
+	}
+}
+
+void FImGuiWindowCache::InvalidateAll()
+{
+	for (auto& Entry : Windows)
+	{
+		Entry.Value.bValid = false;
+	}
+}
+
+void FImGuiWindowCache::Capture(FCachedWindow& Window, const FActiveWindow& Active)
+{
+	const ImDrawList* DrawList = ImGui::GetWindowDrawList();
+
+	const int32 VertexEnd = DrawList->VtxBuffer.Size;
+	const int32 IndexEnd = DrawList->IdxBuffer.Size;
+
+	Window.ContentSize = Relative(ImGuiImplementation::GetCursorMaxPos(), Active.Origin);
+
+	Window.Vertices.SetNumUninitialized(VertexEnd - Active.VertexStart, false);
+	for (int32 Index = 0; Index < Window.Vertices.Num(); Index++)
+	{
+		const ImDrawVert& Vertex = DrawList->VtxBuffer[Active.VertexStart + Index];
+		Window.Vertices[Index] = { Relative(Vertex.pos, Active.Origin), Vertex.uv, Vertex.col };
+	}
+
+	// Indices from content can only reference vertices from content, so we can rebase them to the first vertex.
+	Window.Indices.SetNumUninitialized(IndexEnd - Active.IndexStart, false);
+	for (int32 Index = 0; Index < Window.Indices.Num(); Index++)
+	{
+		Window.Indices[Index] = static_cast<ImDrawIdx>(DrawList->IdxBuffer[Active.IndexStart + Index] - Active.VertexStart);
+	}
+
+	// Keep parts of draw commands that overlap with content.
+	Window.Commands.Reset();
+	for (const ImDrawCmd& Command : DrawList->CmdBuffer)
+	{
+		const int32 CommandStart = FMath::Max(static_cast<int32>(Command.IdxOffset), Active.IndexStart);
+		const int32 CommandEnd = FMath::Min(static_cast<int32>(Command.IdxOffset + Command.ElemCount), IndexEnd);
+		if (CommandStart < CommandEnd && !Command.UserCallback)
+		{
+			const ImVec4 ClipRect{ Command.ClipRect.x - Active.Origin.x, Command.ClipRect.y - Active.Origin.y,
+				Command.ClipRect.z - Active.Origin.x, Command.ClipRect.w - Active.Origin.y };
+			Window.Commands.Add({ ClipRect, Command.TextureId, CommandStart - Active.IndexStart, CommandEnd - CommandStart });
+		}
+	}
+
+	Window.bValid = true;
+}
+
+void FImGuiWindowCache::Emit(const FCachedWindow& Window, const ImVec2& Origin)
+{
+	ImDrawList* DrawList = ImGui::GetWindowDrawList();
+
+	// All vertices are emitted with the first command, so indices from all commands can be rebased to the same vertex.
+	const uint32 BaseVertex = DrawList->_VtxCurrentIdx;
+	int32 NumVerticesToEmit = Window.Vertices.Num();
+
+	for (const FCachedCommand& Command : Window.Commands)
+	{
+		DrawList->PushClipRect(Translate({ Command.ClipRect.x, Command.ClipRect.y }, Origin),
+			Translate({ Command.ClipRect.z, Command.ClipRect.w }, Origin), true);
+		DrawList->PushTextureID(Command.TextureId);
+
+		DrawList->PrimReserve(Command.NumIndices, NumVerticesToEmit);
+
+		for (int32 Index = 0; Index < NumVerticesToEmit; Index++)
+		{
+			const ImDrawVert& Vertex = Window.Vertices[Index];
+			DrawList->_VtxWritePtr[Index] = { Translate(Vertex.pos, Origin), Vertex.uv, Vertex.col };
+		}
+		DrawList->_VtxWritePtr += NumVerticesToEmit;
+		DrawList->_VtxCurrentIdx += NumVerticesToEmit;
+		NumVerticesToEmit = 0;
+
+		for (int32 Index = 0; Index < Command.NumIndices; Index++)
+		{
+			DrawList->_IdxWritePtr[Index] = static_cast<ImDrawIdx>(BaseVertex + Window.Indices[Command.IndexOffset + Index]);
+		}
+		DrawList->_IdxWritePtr += Command.NumIndices;
+
+		DrawList->PopTextureID();
+		DrawList->PopClipRect();
+	}
+
+	// Reserve the same space as the original content, so window size and scrolling are not affected.
+	ImGui::Dummy(Window.ContentSize);
+}
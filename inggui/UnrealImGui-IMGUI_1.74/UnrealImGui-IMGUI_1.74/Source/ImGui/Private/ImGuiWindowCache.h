@@ -0,0 +1,93 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <imgui.h>
+
+
+// Caches draw output of selected ImGui windows in one context, so it can be re-emitted without running window content
+// until its version changes. Window frame and title are drawn by ImGui as usual, only content is cached. Child windows
+// have their own draw lists and are not cached together with their parent. Windows are identified by their ImGui IDs.
+// Re-emitted content is not submitted, so its widgets don't process input until the cache is missed.
+class FImGuiWindowCache
+{
+public:
+
+	// Begin a cached window. Should be used in place of ImGui::Begin and always paired with End.
+	// @param Name - Window name, like in ImGui::Begin
+	// @param ContentVersion - Version of window content, changing it invalidates cached output
+	// @param bOpen - Optional pointer to the window open state, like in ImGui::Begin
+	// @param Flags - Window flags, like in ImGui::Begin
+	// @returns True, if window content needs to be submitted and false, if it was re-emitted from cache or window is
+	//     collapsed
+	bool Begin(const char* Name, uint32 ContentVersion, bool* bOpen, ImGuiWindowFlags Flags);
+
+	// End a cached window. Should be used in place of ImGui::End.
+	void End();
+
+	// Invalidate cached output of a window, forcing its content to be submitted in the next frame.
+	// @param Name - Window name
+	void Invalidate(const char* Name);
+
+	// Invalidate cached output of a window, forcing its content to be submitted in the next frame.
+	// @param WindowId - ImGui window ID
+	void Invalidate(ImGuiID WindowId);
+
+	// Invalidate cached output of all windows.
+	void InvalidateAll();
+
+	// Get the number of times cached output was re-emitted.
+	uint32 GetNumHits() const { return NumHits; }
+
+	// Get the number of times window content needed to be submitted.
+	uint32 GetNumMisses() const { return NumMisses; }
+
+private:
+
+	// Range of cached indices sharing the same texture and clipping rectangle.
+	struct FCachedCommand
+	{
+		// Clipping rectangle relative to content origin.
+		ImVec4 ClipRect;
+		ImTextureID TextureId;
+		int32 IndexOffset;
+		int32 NumIndices;
+	};
+
+	struct FCachedWindow
+	{
+		// Cached output is valid only for the same content version, window size and scroll.
+		uint32 ContentVersion = 0;
+		ImVec2 WindowSize;
+		ImVec2 Scroll;
+		bool bValid = false;
+
+		// Content size, used to reserve space on cache hits.
+		ImVec2 ContentSize;
+
+		// Vertices have positions relative to content origin and indices relative to the first vertex.
+		TArray<ImDrawVert> Vertices;
+		TArray<ImDrawIdx> Indices;
+		TArray<FCachedCommand> Commands;
+	};
+
+	// Window that is between Begin and End.
+	struct FActiveWindow
+	{
+		ImGuiID WindowId = 0;
+		ImVec2 Origin;
+		int32 VertexStart = 0;
+		int32 IndexStart = 0;
+		bool bCapturing = false;
+	};
+
+	void Capture(FCachedWindow& Window, const FActiveWindow& Active);
+	void Emit(const FCachedWindow& Window, const ImVec2& Origin);
+
+	// Cached windows by ImGui window ID.
+	TMap<ImGuiID, FCachedWindow> Windows;
+	TArray<FActiveWindow> ActiveWindows;
+
+	uint32 NumHits = 0;
+	uint32 NumMisses = 0;
+};
@@ -0,0 +1,303 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "TextureAtlas.h"
+
+// Rectangle packer bundled with ImGui. ImGui compiles it with static linkage, so we need our own implementation,
+// unless in unity build it is already a part of the same compilation unit (together with its declarations).
+#ifndef STB_RECT_PACK_IMPLEMENTATION
+#define STBRP_STATIC
+#define STBRP_ASSERT(x) check(x)
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+#endif
+
+
+namespace
+{
+	// Transparent gutter around images, so they don't bleed into each other when filtered.
+	constexpr int32 Padding = 1;
+}
+
+struct FTextureAtlas::FPage
+{
+	FPage()
+	{
+		Nodes.SetNumUninitialized(PageSize);
+		Pixels.SetNumZeroed(PageSize * PageSize);
+		ResetPacking();
+	}
+
+	// Packing context keeps pointers to itself, so pages are never moved.
+	FPage(const FPage&) = delete;
+	FPage& operator=(const FPage&) = delete;
+
+	void ResetPacking()
+	{
+		stbrp_init_target(&Context, PageSize, PageSize, Nodes.GetData(), Nodes.Num());
+	}
+
+	void MarkDirty(const FIntRect& Rect)
+	{
+		if (bDirty)
+		{
+			DirtyRect.Union(Rect);
+		}
+		else
+		{
+			DirtyRect = Rect;
+			bDirty = true;
+		}
+	}
+
+	stbrp_context Context;
+	TArray<stbrp_node> Nodes;
+	TArray<FColor> Pixels;
+
+	TArray<FName> ImageNames;
+	bool bHasReleasedSpace = false;
+
+	FIntRect DirtyRect;
+	bool bDirty = false;
+};
+
+FTextureAtlas::FTextureAtlas() = default;
+FTextureAtlas::~FTextureAtlas() = default;
+
+FTextureAtlas::FTextureAtlas(FTextureAtlas&&) = default;
+FTextureAtlas& FTextureAtlas::operator=(FTextureAtlas&&) = default;
+
+int32 FTextureAtlas::Add(const FName& Name, int32 Width, int32 Height, const FColor* Pixels)
+{
+	checkf(!Images.Contains(Name), TEXT("Image '%s' is already in the atlas."), *Name.ToString());
+
+	if (!IsSmallImage(Width, Height))
+	{
+		return INDEX_NONE;
+	}
+
+	FImage Image;
+	Image.Placement.Width = Width;
+	Image.Placement.Height = Height;
+	Image.Pixels.Append(Pixels, Width * Height);
+
+	bool bAdded = false;
+
+	// Try free space in existing pages first.
+	for (int32 PageIndex = 0; PageIndex < Pages.Num() && !bAdded; PageIndex++)
+	{
+		bAdded = TryAdd(PageIndex, Name, Image);
+	}
+
+	// Repacking moves images that can be already used in this frame, so it is only requested here.
+	for (int32 PageIndex = 0; PageIndex < Pages.Num() && !bAdded && !bRepackRequested; PageIndex++)
+	{
+		bRepackRequested = Pages[PageIndex]->bHasReleasedSpace;
+	}
+
+	if (!bAdded && Pages.Num() < MaxPages)
+	{
+		bAdded = TryAdd(Pages.Add(MakeUnique<FPage>()), Name, Image);
+	}
+
+	if (!bAdded)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 PageIndex = Image.Placement.Page;
+	Images.Add(Name, MoveTemp(Image));
+	return PageIndex;
+}
+
+int32 FTextureAtlas::Update(const FName& Name, const FIntRect& Rect, const FColor* Pixels, int32 SrcPitch)
+{
+	FImage* Image = Images.Find(Name);
+	if (!Image)
+	{
+		return INDEX_NONE;
+	}
+
+	const FPlacement& Placement = Image->Placement;
+	const FIntRect Clamped{ FMath::Max(Rect.Min.X, 0), FMath::Max(Rect.Min.Y, 0),
+		FMath::Min(Rect.Max.X, Placement.Width), FMath::Min(Rect.Max.Y, Placement.Height) };
+
+	if (Clamped.Width() > 0 && Clamped.Height() > 0)
+	{
+		FPage& Page = *Pages[Placement.Page];
+
+		// Update both, the image copy used for repacking and the page.
+		for (int32 Y = Clamped.Min.Y; Y < Clamped.Max.Y; Y++)
+		{
+			const FColor* Src = &Pixels[Y * SrcPitch + Clamped.Min.X];
+			FMemory::Memcpy(&Image->Pixels[Y * Placement.Width + Clamped.Min.X], Src, Clamped.Width() * sizeof(FColor));
+			FMemory::Memcpy(&Page.Pixels[(Placement.Y + Y) * PageSize + Placement.X + Clamped.Min.X], Src, Clamped.Width() * sizeof(FColor));
+		}
+
+		Page.MarkDirty(Clamped + FIntPoint{ Placement.X, Placement.Y });
+	}
+
+	return Placement.Page;
+}
+
+int32 FTextureAtlas::Remove(const FName& Name)
+{
+	FImage Image;
+	if (!Images.RemoveAndCopyValue(Name, Image))
+	{
+		return INDEX_NONE;
+	}
+
+	FPage& Page = *Pages[Image.Placement.Page];
+	Page.ImageNames.RemoveSingleSwap(Name, false);
+
+	if (Page.ImageNames.Num() > 0)
+	{
+		Page.bHasReleasedSpace = true;
+	}
+	else
+	{
+		// The whole page is free. Old pixels don't need to be cleared, because images clear their gutters.
+		Page.ResetPacking();
+		Page.bHasReleasedSpace = false;
+		Page.bDirty = false;
+	}
+
+	return Image.Placement.Page;
+}
+
+int32 FTextureAtlas::GetNumImages(int32 Page) const
+{
+	return Pages[Page]->ImageNames.Num();
+}
+
+const FColor* FTextureAtlas::GetPagePixels(int32 Page) const
+{
+	return Pages[Page]->Pixels.GetData();
+}
+
+bool FTextureAtlas::RepackPages()
+{
+	if (!bRepackRequested)
+	{
+		return false;
+	}
+
+	bRepackRequested = false;
+
+	bool bRepacked = false;
+	for (int32 PageIndex = 0; PageIndex < Pages.Num(); PageIndex++)
+	{
+		if (Pages[PageIndex]->bHasReleasedSpace && TryRepack(PageIndex))
+		{
+			bRepacked = true;
+		}
+	}
+
+	return bRepacked;
+}
+
+bool FTextureAtlas::ConsumeDirtyRect(int32 PageIndex, FIntRect& OutRect)
+{
+	FPage& Page = *Pages[PageIndex];
+	if (Page.bDirty)
+	{
+		OutRect = Page.DirtyRect;
+		Page.bDirty = false;
+		return true;
+	}
+
+	return false;
+}
+
+bool FTextureAtlas::TryAdd(int32 PageIndex, const FName& Name, FImage& Image)
+{
+	FPage& Page = *Pages[PageIndex];
+
+	stbrp_rect Rect{};
+	Rect.w = Image.Placement.Width + 2 * Padding;
+	Rect.h = Image.Placement.Height + 2 * Padding;
+
+	if (!stbrp_pack_rects(&Page.Context, &Rect, 1))
+	{
+		return false;
+	}
+
+	Image.Placement.Page = PageIndex;
+	Image.Placement.X = Rect.x + Padding;
+	Image.Placement.Y = Rect.y + Padding;
+
+	Page.ImageNames.Add(Name);
+	CopyToPage(Page, Image);
+
+	return true;
+}
+
+bool FTextureAtlas::TryRepack(int32 PageIndex)
+{
+	FPage& Page = *Pages[PageIndex];
+
+	// Rectangles of all images remaining in the page.
+	TArray<stbrp_rect> Rects;
+	Rects.Reserve(Page.ImageNames.Num());
+	for (const FName& ImageName : Page.ImageNames)
+	{
+		const FPlacement& Placement = Images[ImageName].Placement;
+		stbrp_rect& Rect = Rects.AddZeroed_GetRef();
+		Rect.w = Placement.Width + 2 * Padding;
+		Rect.h = Placement.Height + 2 * Padding;
+	}
+
+	// Packing from scratch can in rare cases be worse than incremental packing, so test it on a separate context to
+	// keep the page intact, if images don't fit.
+	{
+		TArray<stbrp_node> Nodes;
+		Nodes.SetNumUninitialized(PageSize);
+		stbrp_context Context;
+		stbrp_init_target(&Context, PageSize, PageSize, Nodes.GetData(), Nodes.Num());
+		if (!stbrp_pack_rects(&Context, Rects.GetData(), Rects.Num()))
+		{
+			return false;
+		}
+	}
+
+	// Packing is deterministic, so packing the same rectangles into the page gives the same result.
+	Page.ResetPacking();
+	verify(stbrp_pack_rects(&Page.Context, Rects.GetData(), Rects.Num()));
+
+	for (int32 Index = 0; Index < Page.ImageNames.Num(); Index++)
+	{
+		FImage& PageImage = Images[Page.ImageNames[Index]];
+		PageImage.Placement.X = Rects[Index].x + Padding;
+		PageImage.Placement.Y = Rects[Index].y + Padding;
+		CopyToPage(Page, PageImage);
+	}
+
+	Page.bHasReleasedSpace = false;
+	NumRepacks++;
+
+	return true;
+}
+
+void FTextureAtlas::CopyToPage(FPage& Page, const FImage& Image)
+{
+	const FPlacement& Placement = Image.Placement;
+
+	// Clear the gutter together with the image area, so old content doesn't bleed into this image.
+	const FIntRect Rect{ Placement.X - Padding, Placement.Y - Padding,
+		Placement.X + Placement.Width + Padding, Placement.Y + Placement.Height + Padding };
+
+	for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; Y++)
+	{
+		FMemory::Memzero(&Page.Pixels[Y * PageSize + Rect.Min.X], Rect.Width() * sizeof(FColor));
+	}
+
+	for (int32 Row = 0; Row < Placement.Height; Row++)
+	{
+		FMemory::Memcpy(&Page.Pixels[(Placement.Y + Row) * PageSize + Placement.X], &Image.Pixels[Row * Placement.Width],
+			Placement.Width * sizeof(FColor));
+	}
+
+	Page.MarkDirty(Rect);
+}
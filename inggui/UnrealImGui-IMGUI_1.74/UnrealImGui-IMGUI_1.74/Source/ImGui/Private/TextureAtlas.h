@@ -0,0 +1,126 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Core.h>
+
+
+// Packs small images into shared pages, so they can be drawn with one texture. Keeps a CPU copy of every page and
+// tracks regions that need to be uploaded to page textures. Images never move to a different page, but a page can be
+// repacked to reclaim space of released images, which changes positions of images within that page. Repacking is only
+// done on request (see RepackPages), so positions don't change while geometry using them is built.
+class FTextureAtlas
+{
+public:
+
+	// Size of a page in pixels (pages are square).
+	static constexpr int32 PageSize = 1024;
+
+	// Maximum width and height of an image that can be stored in the atlas.
+	static constexpr int32 MaxImageSize = 128;
+
+	// Maximum number of pages.
+	static constexpr int32 MaxPages = 4;
+
+	// Position of an image in the atlas.
+	struct FPlacement
+	{
+		int32 Page = INDEX_NONE;
+		int32 X = 0;
+		int32 Y = 0;
+		int32 Width = 0;
+		int32 Height = 0;
+	};
+
+	FTextureAtlas();
+	~FTextureAtlas();
+
+	FTextureAtlas(const FTextureAtlas&) = delete;
+	FTextureAtlas& operator=(const FTextureAtlas&) = delete;
+
+	FTextureAtlas(FTextureAtlas&&);
+	FTextureAtlas& operator=(FTextureAtlas&&);
+
+	// Check whether an image of given size can be stored in the atlas.
+	static bool IsSmallImage(int32 Width, int32 Height)
+	{
+		return Width > 0 && Height > 0 && Width <= MaxImageSize && Height <= MaxImageSize;
+	}
+
+	// Add an image to the first page that has space for it. If no page has space, a new page is added. Images never
+	// move here, but if space of released images could be reclaimed, repacking is requested for the next RepackPages.
+	// @param Name - The image name, must not be already in the atlas
+	// @param Width - The image width
+	// @param Height - The image height
+	// @param Pixels - Image pixels, Width * Height values in rows
+	// @returns The index of the page with the image or INDEX_NONE, if the image didn't fit
+	int32 Add(const FName& Name, int32 Width, int32 Height, const FColor* Pixels);
+
+	// Update a region of an image.
+	// @param Name - The image name
+	// @param Rect - The updated region in image pixels, clamped to the image size
+	// @param Pixels - Source pixels of the whole image, of which only Rect is read
+	// @param SrcPitch - The number of pixels in one row of the source
+	// @returns The index of the page with the image or INDEX_NONE, if there is no such image
+	int32 Update(const FName& Name, const FIntRect& Rect, const FColor* Pixels, int32 SrcPitch);
+
+	// Remove an image from the atlas. Space is reclaimed when its page is repacked or released.
+	// @param Name - The image name
+	// @returns The index of the page that had the image or INDEX_NONE, if there was no such image
+	int32 Remove(const FName& Name);
+
+	// Find the placement of an image.
+	// @param Name - The image name
+	// @returns The placement of the image or null, if there is no such image in the atlas
+	const FPlacement* Find(const FName& Name) const
+	{
+		const FImage* Image = Images.Find(Name);
+		return Image ? &Image->Placement : nullptr;
+	}
+
+	// Get the number of pages, including pages without images.
+	int32 GetNumPages() const { return Pages.Num(); }
+
+	// Get the number of images in a page.
+	int32 GetNumImages(int32 Page) const;
+
+	// Get pixels of a page, PageSize * PageSize values in rows.
+	const FColor* GetPagePixels(int32 Page) const;
+
+	// Get the region of a page that changed since the last call and reset it.
+	// @param Page - The page index
+	// @param OutRect - Receives the changed region
+	// @returns True, if a part of the page changed and false otherwise
+	bool ConsumeDirtyRect(int32 Page, FIntRect& OutRect);
+
+	// Repack pages with space of released images, if an image didn't fit in existing pages since the last repacking.
+	// Moved images are marked dirty in their pages and their coordinates change.
+	// @returns True, if any page was repacked and false otherwise
+	bool RepackPages();
+
+	// Get the number of times a page was repacked.
+	uint32 GetNumRepacks() const { return NumRepacks; }
+
+private:
+
+	struct FPage;
+
+	struct FImage
+	{
+		FPlacement Placement;
+
+		// Image pixels are kept to support repacking.
+		TArray<FColor> Pixels;
+	};
+
+	bool TryAdd(int32 PageIndex, const FName& Name, FImage& Image);
+	bool TryRepack(int32 PageIndex);
+
+	void CopyToPage(FPage& Page, const FImage& Image);
+
+	TMap<FName, FImage> Images;
+	TArray<TUniquePtr<FPage>> Pages;
+
+	uint32 NumRepacks = 0;
+	bool bRepackRequested = false;
+};
@@ -28,6 +28,166 @@ TextureIndex FTextureManager::CreatePlainTexture(const FName& Name, int32 Width,
 	return CreatePlainTextureInternal(Name, Width, Height, Color);
 }
 
+TextureIndex FTextureManager::CreateTextureFromAlpha(const FName& Name, int32 Width, int32 Height, const uint8* Alpha)
+{
+	checkf(Name != NAME_None, TEXT("Trying to create a texture with a name 'NAME_None' is not allowed."));
+	checkf(FindTextureIndex(Name) == INDEX_NONE, TEXT("Trying to create texture using name '%s' that is already registered."), *Name.ToString());
+
+	// Expanded data only live until they are uploaded.
+	const int32 NumPixels = Width * Height;
+	FColor* SrcData = new FColor[NumPixels];
+	for (int32 Index = 0; Index < NumPixels; Index++)
+	{
+		SrcData[Index] = FColor{ 255, 255, 255, Alpha[Index] };
+	}
+	auto SrcDataCleanup = [](uint8* Data) { delete[] reinterpret_cast<FColor*>(Data); };
+
+	return CreateTextureInternal(Name, Width, Height, sizeof(FColor), reinterpret_cast<uint8*>(SrcData), SrcDataCleanup);
+}
+
+TextureIndex FTextureManager::CreateAtlasTexture(const FName& Name, int32 Width, int32 Height, const FColor* Pixels)
+{
+	checkf(Name != NAME_None, TEXT("Trying to create a texture with a name 'NAME_None' is not allowed."));
+	checkf(FindTextureIndex(Name) == INDEX_NONE, TEXT("Trying to create texture using name '%s' that is already registered."), *Name.ToString());
+
+	const int32 Page = Atlas.Add(Name, Width, Height, Pixels);
+	if (Page != INDEX_NONE)
+	{
+		return UpdateAtlasPage(Page);
+	}
+
+	// Texture is too big for the atlas or the atlas is full.
+	const int32 NumPixels = Width * Height;
+	FColor* SrcData = new FColor[NumPixels];
+	FMemory::Memcpy(SrcData, Pixels, NumPixels * sizeof(FColor));
+	auto SrcDataCleanup = [](uint8* Data) { delete[] reinterpret_cast<FColor*>(Data); };
+
+	return CreateTextureInternal(Name, Width, Height, sizeof(FColor), reinterpret_cast<uint8*>(SrcData), SrcDataCleanup);
+}
+
+void FTextureManager::GetTextureUVs(const FName& Name, FVector2D& OutUV0, FVector2D& OutUV1) const
+{
+	if (const FTextureAtlas::FPlacement* Placement = Atlas.Find(Name))
+	{
+		constexpr float Scale = 1.f / FTextureAtlas::PageSize;
+		OutUV0 = { Placement->X * Scale, Placement->Y * Scale };
+		OutUV1 = { (Placement->X + Placement->Width) * Scale, (Placement->Y + Placement->Height) * Scale };
+	}
+	else
+	{
+		OutUV0 = { 0.f, 0.f };
+		OutUV1 = { 1.f, 1.f };
+	}
+}
+
+bool FTextureManager::ReleaseAtlasTexture(const FName& Name)
+{
+	const int32 Page = Atlas.Remove(Name);
+	if (Page == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Textures of empty pages are released and created again when needed.
+	if (Atlas.GetNumImages(Page) == 0 && AtlasPageTextures[Page] != INDEX_NONE)
+	{
+		ReleaseTextureResources(AtlasPageTextures[Page]);
+		AtlasPageTextures[Page] = INDEX_NONE;
+	}
+
+	return true;
+}
+
+void FTextureManager::UpdateTextureRegions(TextureIndex Index, TArrayView<const FIntRect> Rects, const FColor* Pixels, int32 SrcPitch)
+{
+	checkf(IsValidTexture(Index), TEXT("Invalid texture index %d."), Index);
+
+	UTexture2D* Texture = Cast<UTexture2D>(TextureResources[Index].Brush.GetResourceObject());
+	if (!Texture)
+	{
+		return;
+	}
+
+	if (!UpdateQueue)
+	{
+		UpdateQueue = MakeUnique<FTextureUpdateQueue>();
+	}
+
+	for (const FIntRect& Rect : Rects)
+	{
+		UpdateQueue->Add(Texture, Rect, Pixels, SrcPitch);
+	}
+}
+
+void FTextureManager::UpdateTextureRegionsFromAlpha(TextureIndex Index, TArrayView<const FIntRect> Rects, const uint8* Alpha, int32 SrcPitch)
+{
+	checkf(IsValidTexture(Index), TEXT("Invalid texture index %d."), Index);
+
+	UTexture2D* Texture = Cast<UTexture2D>(TextureResources[Index].Brush.GetResourceObject());
+	if (!Texture)
+	{
+		return;
+	}
+
+	if (!UpdateQueue)
+	{
+		UpdateQueue = MakeUnique<FTextureUpdateQueue>();
+	}
+
+	for (const FIntRect& Rect : Rects)
+	{
+		UpdateQueue->AddAlpha(Texture, Rect, Alpha, SrcPitch);
+	}
+}
+
+bool FTextureManager::UpdateAtlasTextureRegions(const FName& Name, TArrayView<const FIntRect> Rects, const FColor* Pixels, int32 SrcPitch)
+{
+	int32 Page = INDEX_NONE;
+	for (const FIntRect& Rect : Rects)
+	{
+		Page = Atlas.Update(Name, Rect, Pixels, SrcPitch);
+		if (Page == INDEX_NONE)
+		{
+			return false;
+		}
+	}
+
+	// Regions are merged in the page, so they are staged as one update.
+	if (Page != INDEX_NONE)
+	{
+		UpdateAtlasPage(Page);
+	}
+
+	return Atlas.Find(Name) != nullptr;
+}
+
+void FTextureManager::FlushTextureUpdates()
+{
+	if (UpdateQueue)
+	{
+		UpdateQueue->Flush();
+	}
+}
+
+bool FTextureManager::RepackAtlas()
+{
+	if (!Atlas.RepackPages())
+	{
+		return false;
+	}
+
+	for (int32 Page = 0; Page < Atlas.GetNumPages(); Page++)
+	{
+		// Pages without textures are created with their whole content, when they are used again.
+		if (AtlasPageTextures.IsValidIndex(Page) && AtlasPageTextures[Page] != INDEX_NONE)
+		{
+			UpdateAtlasPage(Page);
+		}
+	}
+
+	return true;
+}
+
 TextureIndex FTextureManager::CreateTextureResources(const FName& Name, UTexture2D* Texture, bool bMakeUnique)
 {
 	checkf(Name != NAME_None, TEXT("Trying to create texture resources with a name 'NAME_None' is not allowed."));
@@ -38,6 +198,11 @@ TextureIndex FTextureManager::CreateTextureResources(const FName& Name, UTexture
 		checkf(FindTextureIndex(Name) == INDEX_NONE, TEXT("Trying to create texture resources using name '%s' that is already registered.")
 			TEXT(" Consider using different name or set bMakeUnique parameter to false."), *Name.ToString());
 	}
+	else
+	{
+		// A texture with that name packed into the atlas is replaced, not its page.
+		ReleaseAtlasTexture(Name);
+	}
 
 	// Create an entry for the texture.
 	return AddTextureEntry(Name, Texture, false, true);
@@ -47,6 +212,12 @@ void FTextureManager::ReleaseTextureResources(TextureIndex Index)
 {
 	checkf(IsInRange(Index), TEXT("Invalid texture index %d. Texture resources array has %d entries total."), Index, TextureResources.Num());
 
+	if (IsValidTexture(Index))
+	{
+		TextureIndices.Remove(TextureResources[Index].Name);
+		FreeIndices.Add(Index);
+	}
+
 	TextureResources[Index] = {};
 }
 
@@ -94,27 +265,67 @@ TextureIndex FTextureManager::CreatePlainTextureInternal(const FName& Name, int3
 	return CreateTextureInternal(Name, Width, Height, Bpp, SrcData, SrcDataCleanup);
 }
 
+TextureIndex FTextureManager::FindAtlasTextureIndex(const FName& Name) const
+{
+	const FTextureAtlas::FPlacement* Placement = Atlas.Find(Name);
+	return Placement && AtlasPageTextures.IsValidIndex(Placement->Page) ? AtlasPageTextures[Placement->Page] : INDEX_NONE;
+}
+
+TextureIndex FTextureManager::UpdateAtlasPage(int32 Page)
+{
+	while (AtlasPageTextures.Num() <= Page)
+	{
+		AtlasPageTextures.Add(INDEX_NONE);
+	}
+
+	TextureIndex& Index = AtlasPageTextures[Page];
+
+	FIntRect DirtyRect;
+	const bool bDirty = Atlas.ConsumeDirtyRect(Page, DirtyRect);
+
+	if (Index == INDEX_NONE)
+	{
+		// Create the page texture with the whole content.
+		constexpr int32 NumPixels = FTextureAtlas::PageSize * FTextureAtlas::PageSize;
+		FColor* SrcData = new FColor[NumPixels];
+		FMemory::Memcpy(SrcData, Atlas.GetPagePixels(Page), NumPixels * sizeof(FColor));
+		auto SrcDataCleanup = [](uint8* Data) { delete[] reinterpret_cast<FColor*>(Data); };
+
+		Index = CreateTextureInternal(FName{ "ImGuiModule_AtlasPage", Page }, FTextureAtlas::PageSize, FTextureAtlas::PageSize,
+			sizeof(FColor), reinterpret_cast<uint8*>(SrcData), SrcDataCleanup);
+	}
+	else if (bDirty)
+	{
+		UpdateTextureRegions(Index, MakeArrayView(&DirtyRect, 1), Atlas.GetPagePixels(Page), FTextureAtlas::PageSize);
+	}
+
+	return Index;
+}
+
 TextureIndex FTextureManager::AddTextureEntry(const FName& Name, UTexture2D* Texture, bool bAddToRoot, bool bUpdate)
 {
 	// If we update try to find entry with that name.
-	TextureIndex Index = bUpdate ? FindTextureIndex(Name) : INDEX_NONE;
+	const TextureIndex* ExistingIndex = bUpdate ? TextureIndices.Find(Name) : nullptr;
+	TextureIndex Index = ExistingIndex ? *ExistingIndex : INDEX_NONE;
 
-	// If we didn't find, try to find and entry to reuse.
-	if (Index == INDEX_NONE)
+	// If we didn't find, try to reuse a released entry.
+	if (Index == INDEX_NONE && FreeIndices.Num() > 0)
 	{
-		Index = FindTextureIndex(NAME_None);
+		Index = FreeIndices.Pop(false);
 	}
 
 	// Either update/reuse entry or add a new one.
 	if (Index != INDEX_NONE)
 	{
 		TextureResources[Index] = { Name, Texture, bAddToRoot };
-		return Index;
 	}
 	else
 	{
-		return TextureResources.Emplace(Name, Texture, bAddToRoot);
+		Index = TextureResources.Emplace(Name, Texture, bAddToRoot);
 	}
+
+	TextureIndices.Add(Name, Index);
+	return Index;
 }
 
 FTextureManager::FTextureEntry::FTextureEntry(const FName& InName, UTexture2D* InTexture, bool bAddToRoot)
@@ -184,3 +395,113 @@ void FTextureManager::FTextureEntry::Reset(bool bReleaseResources)
 	Brush = FSlateNoResource();
 	ResourceHandle = FSlateResourceHandle();
 }
+
+
+//----------------------------------------------------------------------------------------------------
+// Developer benchmarks
+//----------------------------------------------------------------------------------------------------
+
+#if IMGUI_MODULE_DEVELOPER
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiTextureManager, Log, All);
+
+namespace
+{
+	// Registers many textures in a separate manager and compares hashed lookups with a linear search over the same
+	// names, which is what lookups used to cost. Releasing and re-registering a part of textures verifies that released
+	// entries are reused.
+	void BenchmarkTextureLookup(const TArray<FString>& Args)
+	{
+		const int32 NumTextures = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10000;
+		const int32 NumLookups = 100000;
+
+		// All entries can share one texture, because only registration and lookup are measured.
+		UTexture2D* Texture = UTexture2D::CreateTransient(2, 2);
+		Texture->UpdateResource();
+
+		TArray<FName> Names;
+		Names.Reserve(NumTextures);
+		for (int32 Index = 0; Index < NumTextures; Index++)
+		{
+			Names.Emplace(*FString::Printf(TEXT("ImGuiBenchmark_%d"), Index));
+		}
+
+		FRandomStream Random{ 0x7E47 };
+		TArray<FName> LookupNames;
+		LookupNames.Reserve(NumLookups);
+		for (int32 Index = 0; Index < NumLookups; Index++)
+		{
+			LookupNames.Add(Names[Random.RandRange(0, NumTextures - 1)]);
+		}
+
+		FTextureManager TextureManager;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (const FName& Name : Names)
+		{
+			TextureManager.CreateTextureResources(Name, Texture);
+		}
+		const double RegistrationSeconds = FPlatformTime::Seconds() - StartTime;
+
+		int64 IndexSum = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (const FName& Name : LookupNames)
+		{
+			IndexSum += TextureManager.FindTextureIndex(Name);
+		}
+		const double HashedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		int64 LinearIndexSum = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (const FName& Name : LookupNames)
+		{
+			LinearIndexSum += Names.IndexOfByKey(Name);
+		}
+		const double LinearSeconds = FPlatformTime::Seconds() - StartTime;
+
+		// Release every other texture and register it again under a new name. All of them should reuse released
+		// entries.
+		for (int32 Index = 0; Index < NumTextures; Index += 2)
+		{
+			TextureManager.ReleaseTextureResources(Index);
+		}
+
+		int32 NumErrors = 0;
+		for (int32 Index = 0; Index < NumTextures; Index += 2)
+		{
+			const FName Name{ *FString::Printf(TEXT("ImGuiBenchmark_Reused_%d"), Index) };
+			const TextureIndex NewIndex = TextureManager.CreateTextureResources(Name, Texture);
+			if (NewIndex >= NumTextures || TextureManager.FindTextureIndex(Names[Index]) != INDEX_NONE
+				|| TextureManager.FindTextureIndex(Name) != NewIndex)
+			{
+				NumErrors++;
+			}
+		}
+
+		if (IndexSum != LinearIndexSum)
+		{
+			NumErrors++;
+		}
+
+		UE_LOG(LogImGuiTextureManager, Display, TEXT("Registered %d textures in %.3f ms. %d lookups: hashed %.3f ms, linear %.3f ms (x%.1f)."),
+			NumTextures, RegistrationSeconds * 1000.0, NumLookups, HashedSeconds * 1000.0, LinearSeconds * 1000.0,
+			HashedSeconds > 0.0 ? LinearSeconds / HashedSeconds : 0.0);
+
+		if (NumErrors > 0)
+		{
+			UE_LOG(LogImGuiTextureManager, Error, TEXT("Texture lookup or entry reuse gave %d unexpected results."), NumErrors);
+		}
+
+		for (int32 Index = 0; Index < NumTextures; Index++)
+		{
+			TextureManager.ReleaseTextureResources(Index);
+		}
+	}
+
+	FAutoConsoleCommand BenchmarkTextureLookupCommand(TEXT("ImGui.Debug.BenchmarkTextureLookup"),
+		TEXT("Register many textures in a separate texture manager and measure lookups by name.\n")
+		TEXT("Arguments: [NumTextures] (default 10000)"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkTextureLookup));
+}
+
+#endif // IMGUI_MODULE_DEVELOPER
@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include "TextureAtlas.h"
+#include "TextureUpdateQueue.h"
+
 #include <Core.h>
 #include <Styling/SlateBrush.h>
 #include <Textures/SlateShaderResource.h>
@@ -34,12 +37,13 @@ public:
 	// @param Color - The color of the error texture
 	void InitializeErrorTexture(const FColor& Color);
 
-	// Find texture index by name.
+	// Find texture index by name. For textures packed into the atlas, it is the index of their page texture.
 	// @param Name - The name of a texture to find
 	// @returns The index of a texture with given name or INDEX_NONE if there is no such texture
 	TextureIndex FindTextureIndex(const FName& Name) const
 	{
-		return TextureResources.IndexOfByPredicate([&](const auto& Entry) { return Entry.Name == Name; });
+		const TextureIndex* Index = TextureIndices.Find(Name);
+		return Index ? *Index : FindAtlasTextureIndex(Name);
 	}
 
 	// Get the name of a texture at given index. Returns NAME_None, if index is out of range.
@@ -70,6 +74,16 @@ public:
 	// @returns The index of a texture that was created
 	TextureIndex CreateTexture(const FName& Name, int32 Width, int32 Height, uint32 SrcBpp, uint8* SrcData, TFunction<void(uint8*)> SrcDataCleanup = [](uint8*) {});
 
+	// Create a texture from single-channel coverage, like font atlas alpha data. Pixels are white with alpha from the
+	// source, so the texture renders like one created from ImGui RGBA32 data, while the source can be 4 times smaller.
+	// Throws exception if there is already a texture with that name.
+	// @param Name - The texture name
+	// @param Width - The texture width
+	// @param Height - The texture height
+	// @param Alpha - The source alpha values, Width * Height values in rows
+	// @returns The index of a texture that was created
+	TextureIndex CreateTextureFromAlpha(const FName& Name, int32 Width, int32 Height, const uint8* Alpha);
+
 	// Create a plain texture. Throws exception if there is already a texture with that name.
 	// @param Name - The texture name
 	// @param Width - The texture width
@@ -78,6 +92,63 @@ public:
 	// @returns The index of a texture that was created
 	TextureIndex CreatePlainTexture(const FName& Name, int32 Width, int32 Height, FColor Color);
 
+	// Create a texture from pixels. Small textures are packed into shared atlas pages (see FTextureAtlas), so they can
+	// be drawn together, larger textures or textures that don't fit in the atlas are created separately. Throws
+	// exception if there is already a texture with that name.
+	// @param Name - The texture name
+	// @param Width - The texture width
+	// @param Height - The texture height
+	// @param Pixels - The texture pixels, Width * Height values in rows
+	// @returns The index of a texture that contains the pixels, which for atlas textures is shared by the whole page
+	TextureIndex CreateAtlasTexture(const FName& Name, int32 Width, int32 Height, const FColor* Pixels);
+
+	// Get texture coordinates of a texture. Textures in the atlas are mapped to their page area, other textures to the
+	// full range. Coordinates of atlas textures can change when their page is repacked.
+	// @param Name - The texture name
+	// @param OutUV0 - Receives coordinates of the upper-left corner
+	// @param OutUV1 - Receives coordinates of the lower-right corner
+	void GetTextureUVs(const FName& Name, FVector2D& OutUV0, FVector2D& OutUV1) const;
+
+	// Release a texture that was packed into the atlas. Releases the page texture, if it has no more textures.
+	// @param Name - The texture name
+	// @returns True, if texture was in the atlas and false otherwise
+	bool ReleaseAtlasTexture(const FName& Name);
+
+	// Update regions of a texture. Pixels are copied and sent to the render thread with other updates in
+	// FlushTextureUpdates. Texture needs to be in PF_B8G8R8A8 format, which is true for all textures created by this
+	// manager.
+	// @param Index - The texture index
+	// @param Rects - Regions to update
+	// @param Pixels - Source pixels of the whole texture, of which only updated regions are read
+	// @param SrcPitch - The number of pixels in one row of the source
+	void UpdateTextureRegions(TextureIndex Index, TArrayView<const FIntRect> Rects, const FColor* Pixels, int32 SrcPitch);
+
+	// Update regions of a texture from single-channel coverage, like font atlas alpha data. Works like
+	// UpdateTextureRegions, but values are expanded to white pixels with that alpha, while they are copied.
+	// @param Index - The texture index
+	// @param Rects - Regions to update
+	// @param Alpha - Source alpha values of the whole texture, of which only updated regions are read
+	// @param SrcPitch - The number of values in one row of the source
+	void UpdateTextureRegionsFromAlpha(TextureIndex Index, TArrayView<const FIntRect> Rects, const uint8* Alpha, int32 SrcPitch);
+
+	// Update regions of a texture that was packed into the atlas. Works like UpdateTextureRegions, but regions are in
+	// the texture space, not in the atlas page.
+	// @param Name - The texture name
+	// @param Rects - Regions to update
+	// @param Pixels - Source pixels of the whole texture, of which only updated regions are read
+	// @param SrcPitch - The number of pixels in one row of the source
+	// @returns True, if texture was in the atlas and false otherwise
+	bool UpdateAtlasTextureRegions(const FName& Name, TArrayView<const FIntRect> Rects, const FColor* Pixels, int32 SrcPitch);
+
+	// Send all texture updates from this frame to the render thread in one render command.
+	void FlushTextureUpdates();
+
+	// Repack atlas pages to reclaim space of released textures, if new textures didn't fit in the atlas. Coordinates of
+	// moved textures change, so this should be called between frames, after texture updates were flushed. Moved
+	// pixels are sent with the next flush, after draw data with the old coordinates were drawn.
+	// @returns True, if coordinates of any atlas texture changed and false otherwise
+	bool RepackAtlas();
+
 	// Create Slate resources to an existing texture, managed externally. As part of an external interface it allows
 	// to loosen resource verification policy. By default (consistently with other create function) it protects from
 	// creating resources with name that is already registered. If bMakeUnique is false, then existing resources are
@@ -112,6 +183,16 @@ private:
 	// @returns The index of the entry that we created or reused
 	TextureIndex AddTextureEntry(const FName& Name, UTexture2D* Texture, bool bAddToRoot, bool bUpdate);
 
+	// Find the index of the page texture of a texture packed into the atlas.
+	// @param Name - The texture name
+	// @returns The index of the page texture or INDEX_NONE if texture is not in the atlas
+	TextureIndex FindAtlasTextureIndex(const FName& Name) const;
+
+	// Upload changed part of an atlas page, creating its texture if needed.
+	// @param Page - The page index
+	// @returns The index of the page texture
+	TextureIndex UpdateAtlasPage(int32 Page);
+
 	// Check whether index is in range allocated for TextureResources (it doesn't mean that resources are valid).
 	FORCEINLINE bool IsInRange(TextureIndex Index) const
 	{
@@ -153,6 +234,20 @@ private:
 	TArray<FTextureEntry> TextureResources;
 	FTextureEntry ErrorTexture;
 
+	// Indices of valid entries by name, so lookups don't need to search resources. Textures packed into the atlas are
+	// not here, they are found by name in the atlas, so they never alias entries of their page textures.
+	TMap<FName, TextureIndex> TextureIndices;
+
+	// Indices of released entries that can be reused.
+	TArray<TextureIndex> FreeIndices;
+
+	// Staged texture updates, created on the first update.
+	TUniquePtr<FTextureUpdateQueue> UpdateQueue;
+
+	// Atlas for small textures and indices of its page textures (INDEX_NONE for pages without texture).
+	FTextureAtlas Atlas;
+	TArray<TextureIndex> AtlasPageTextures;
+
 	static constexpr EName NAME_ErrorTexture = NAME_None;
 	static constexpr TextureIndex INDEX_ErrorTexture = INDEX_NONE;
 };
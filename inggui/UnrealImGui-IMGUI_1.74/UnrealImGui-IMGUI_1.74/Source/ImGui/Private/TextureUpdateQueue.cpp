@@ -0,0 +1,134 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "TextureUpdateQueue.h"
+
+#include <RenderingThread.h>
+#include <TextureResource.h>
+
+
+FTextureUpdateQueue::~FTextureUpdateQueue()
+{
+	// Render thread may still read from staging buffers.
+	for (FBuffer& Buffer : Buffers)
+	{
+		Buffer.Fence.Wait();
+	}
+}
+
+void FTextureUpdateQueue::Add(UTexture2D* Texture, const FIntRect& Rect, const FColor* SrcPixels, int32 SrcPitch)
+{
+	if (FColor* Dst = Stage(Texture, Rect))
+	{
+		const int32 Width = Rect.Width();
+		for (int32 Row = 0; Row < Rect.Height(); Row++)
+		{
+			FMemory::Memcpy(&Dst[Row * Width], &SrcPixels[(Rect.Min.Y + Row) * SrcPitch + Rect.Min.X], Width * sizeof(FColor));
+		}
+	}
+}
+
+void FTextureUpdateQueue::AddAlpha(UTexture2D* Texture, const FIntRect& Rect, const uint8* SrcAlpha, int32 SrcPitch)
+{
+	if (FColor* Dst = Stage(Texture, Rect))
+	{
+		const int32 Width = Rect.Width();
+		for (int32 Row = 0; Row < Rect.Height(); Row++)
+		{
+			const uint8* Src = &SrcAlpha[(Rect.Min.Y + Row) * SrcPitch + Rect.Min.X];
+			for (int32 Column = 0; Column < Width; Column++)
+			{
+				Dst[Row * Width + Column] = FColor{ 255, 255, 255, Src[Column] };
+			}
+		}
+	}
+}
+
+FColor* FTextureUpdateQueue::Stage(UTexture2D* Texture, const FIntRect& Rect)
+{
+	checkf(Texture, TEXT("Null texture."));
+	checkf(Texture->GetPixelFormat() == PF_B8G8R8A8, TEXT("Only textures in PF_B8G8R8A8 format can be updated. Texture '%s' has format %d."),
+		*Texture->GetName(), static_cast<int32>(Texture->GetPixelFormat()));
+
+	const int32 Width = Rect.Width();
+	const int32 Height = Rect.Height();
+	if (Width <= 0 || Height <= 0)
+	{
+		return nullptr;
+	}
+
+	FBuffer& Buffer = Buffers[CurrentBuffer];
+
+	// First update after the buffer was sent two flushes ago. It is almost always already read by the render thread,
+	// but we need to be sure before we overwrite it.
+	if (Buffer.Updates.Num() == 0)
+	{
+		Buffer.Fence.Wait();
+		Buffer.Data.Reset();
+	}
+
+	const int32 DataOffset = Buffer.Data.Num();
+	Buffer.Data.AddUninitialized(Width * Height * sizeof(FColor));
+
+	Buffer.Updates.Add({ Texture, FUpdateTextureRegion2D(Rect.Min.X, Rect.Min.Y, 0, 0, Width, Height), DataOffset });
+
+	return reinterpret_cast<FColor*>(&Buffer.Data[DataOffset]);
+}
+
+void FTextureUpdateQueue::Flush()
+{
+	FBuffer& Buffer = Buffers[CurrentBuffer];
+	if (Buffer.Updates.Num() == 0)
+	{
+		return;
+	}
+
+	struct FRenderUpdate
+	{
+		FTextureResource* Resource;
+		FUpdateTextureRegion2D Region;
+		const uint8* Data;
+	};
+
+	// Resolve resources on the game thread, skipping textures that were destroyed since their update was staged.
+	TArray<FRenderUpdate> RenderUpdates;
+	RenderUpdates.Reserve(Buffer.Updates.Num());
+	for (const FUpdate& Update : Buffer.Updates)
+	{
+		if (UTexture2D* Texture = Update.Texture.Get())
+		{
+#if ENGINE_COMPATIBILITY_LEGACY_TEXTURE_RHI
+			FTextureResource* Resource = Texture->Resource;
+#else
+			FTextureResource* Resource = Texture->GetResource();
+#endif
+			if (Resource)
+			{
+				RenderUpdates.Add({ Resource, Update.Region, &Buffer.Data[Update.DataOffset] });
+			}
+		}
+	}
+
+	ENQUEUE_RENDER_COMMAND(ImGuiUpdateTextureRegions)(
+		[RenderUpdates = MoveTemp(RenderUpdates)](FRHICommandListImmediate& RHICmdList)
+		{
+			for (const FRenderUpdate& Update : RenderUpdates)
+			{
+				if (Update.Resource->TextureRHI.IsValid())
+				{
+					const uint32 Pitch = Update.Region.Width * sizeof(FColor);
+#if ENGINE_COMPATIBILITY_LEGACY_TEXTURE_RHI
+					RHIUpdateTexture2D(Update.Resource->TextureRHI->GetTexture2D(), 0, Update.Region, Pitch, Update.Data);
+#else
+					RHICmdList.UpdateTexture2D(Update.Resource->TextureRHI, 0, Update.Region, Pitch, Update.Data);
+#endif
+				}
+			}
+		});
+
+	Buffer.Fence.BeginFence();
+	Buffer.Updates.Reset();
+
+	CurrentBuffer = 1 - CurrentBuffer;
+}
@@ -0,0 +1,67 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Core.h>
+#include <Engine/Texture2D.h>
+#include <RenderCommandFence.h>
+
+
+// Collects partial texture updates during a frame and sends them to the render thread in one render command. Pixels
+// are copied to CPU staging memory, which is double-buffered: one buffer is filled while the render thread reads the
+// other one. Buffers keep their memory between frames, so in steady state staging doesn't allocate.
+class FTextureUpdateQueue
+{
+public:
+
+	FTextureUpdateQueue() = default;
+	~FTextureUpdateQueue();
+
+	FTextureUpdateQueue(const FTextureUpdateQueue&) = delete;
+	FTextureUpdateQueue& operator=(const FTextureUpdateQueue&) = delete;
+
+	// Stage an update of a texture region. Texture needs to be in PF_B8G8R8A8 format.
+	// @param Texture - The texture to update
+	// @param Rect - The region to update
+	// @param SrcPixels - The source pixels, of which Rect is copied
+	// @param SrcPitch - The number of pixels in one row of the source
+	void Add(UTexture2D* Texture, const FIntRect& Rect, const FColor* SrcPixels, int32 SrcPitch);
+
+	// Stage an update of a texture region from single-channel coverage, which is expanded to white pixels with that
+	// alpha. Texture needs to be in PF_B8G8R8A8 format.
+	// @param Texture - The texture to update
+	// @param Rect - The region to update
+	// @param SrcAlpha - The source alpha values, of which Rect is copied
+	// @param SrcPitch - The number of values in one row of the source
+	void AddAlpha(UTexture2D* Texture, const FIntRect& Rect, const uint8* SrcAlpha, int32 SrcPitch);
+
+	// Send all staged updates to the render thread in one render command.
+	void Flush();
+
+	// Get the number of updates staged since the last flush.
+	int32 GetNumPendingUpdates() const { return Buffers[CurrentBuffer].Updates.Num(); }
+
+private:
+
+	struct FUpdate
+	{
+		TWeakObjectPtr<UTexture2D> Texture;
+		FUpdateTextureRegion2D Region;
+		int32 DataOffset;
+	};
+
+	struct FBuffer
+	{
+		TArray<uint8> Data;
+		TArray<FUpdate> Updates;
+
+		// Signalled when the render thread finished reading data.
+		FRenderCommandFence Fence;
+	};
+
+	// Allocate staging memory for an update and return it, or null if the region is empty.
+	FColor* Stage(UTexture2D* Texture, const FIntRect& Rect);
+
+	FBuffer Buffers[2];
+	int32 CurrentBuffer = 0;
+};
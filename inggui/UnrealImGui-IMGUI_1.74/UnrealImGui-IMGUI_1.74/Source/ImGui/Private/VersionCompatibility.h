@@ -31,3 +31,7 @@
 // Starting from version 4.24, world actor tick event has additional world parameter.
 #define ENGINE_COMPATIBILITY_LEGACY_WORLD_ACTOR_TICK    BELOW_ENGINE_VERSION(4, 24)
 
+// Starting from version 5.1, texture resources are accessed through UTexture::GetResource() and RHI textures have one
+// type for all dimensions.
+#define ENGINE_COMPATIBILITY_LEGACY_TEXTURE_RHI         BELOW_ENGINE_VERSION(5, 1)
+
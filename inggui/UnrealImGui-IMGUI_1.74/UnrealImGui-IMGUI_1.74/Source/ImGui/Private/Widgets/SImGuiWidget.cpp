@@ -57,6 +57,9 @@ namespace CVars
 }
 #endif // IMGUI_WIDGET_DEBUG
 
+DECLARE_CYCLE_STAT(TEXT("Paint"), STAT_ImGuiPaint, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Conversion"), STAT_ImGuiConversion, STATGROUP_ImGui);
+
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 void SImGuiWidget::Construct(const FArguments& InArgs)
 {
@@ -532,58 +535,105 @@ int32 SImGuiWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeo
 		// keep frame tearing at minimum because it is executed at the very end of the frame.
 		ContextProxy->Tick(FSlateApplication::Get().GetDeltaTime());
 
+		SCOPE_CYCLE_COUNTER(STAT_ImGuiPaint);
+		FImGuiContextStatsScope StatsScope{ ContextProxy->GetStats(), FImGuiContextStats::ETimer::Paint };
+
 		// Calculate transform from ImGui to screen space. Rounding translation is necessary to keep it pixel-perfect
 		// in older engine versions.
 		const FSlateRenderTransform& WidgetToScreen = AllottedGeometry.GetAccumulatedRenderTransform();
 		const FSlateRenderTransform ImGuiToScreen = RoundTranslation(ImGuiRenderTransform.Concatenate(WidgetToScreen));
 
+#if IMGUI_WIDGET_DEBUG
+		CollectRenderStats(ContextProxy->GetDrawData(), ImGuiToScreen, MyClippingRect);
+#endif // IMGUI_WIDGET_DEBUG
+
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 		// Convert clipping rectangle to format required by Slate vertex.
 		const FSlateRotatedRect VertexClippingRect{ MyClippingRect };
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 
 		for (const auto& DrawList : ContextProxy->GetDrawData())
 		{
-#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-			DrawList.CopyVertexData(VertexBuffer, ImGuiToScreen, VertexClippingRect);
-
 			// Get access to the Slate scissor rectangle defined in Slate Core API, so we can customize elements drawing.
 			extern SLATECORE_API TOptional<FShortRect> GSlateScissorRect;
 			auto GSlateScissorRectSaver = ScopeGuards::MakeStateSaver(GSlateScissorRect);
-#else
-			DrawList.CopyVertexData(VertexBuffer, ImGuiToScreen);
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-
-			int IndexBufferOffset = 0;
-			for (int CommandNb = 0; CommandNb < DrawList.NumCommands(); CommandNb++)
-			{
-				const auto& DrawCommand = DrawList.GetCommand(CommandNb, ImGuiToScreen);
 
-				DrawList.CopyIndexData(IndexBuffer, IndexBufferOffset, DrawCommand.NumElements);
+			// Merge consecutive commands sharing texture and clipping rectangle, so we can draw them as one element.
+			// Commands outside of the widget are skipped before their vertices are converted.
+			const int32 NumCulledCommands = DrawList.GetBatches(DrawBatches, ImGuiToScreen, &MyClippingRect);
+			ContextProxy->GetStats().AddCount(FImGuiContextStats::ECounter::CulledDrawCommands, NumCulledCommands);
 
-				// Advance offset by number of copied elements to position it for the next command.
-				IndexBufferOffset += DrawCommand.NumElements;
+			for (const FImGuiDrawBatch& Batch : DrawBatches)
+			{
+				// Slate copies vertices and indices for every element, so we only pass vertices referenced by this
+				// batch and rebase indices to match.
+				DrawList.CopyVertexData(VertexBuffer, ImGuiToScreen, Batch.VertexOffset, Batch.NumVertices, VertexClippingRect);
+				DrawList.CopyIndexData(IndexBuffer, Batch.IndexOffset, Batch.NumIndices, Batch.VertexOffset);
 
-				// Get texture resource handle for this draw command (null index will be also mapped to a valid texture).
-				const FSlateResourceHandle& Handle = ModuleManager->GetTextureManager().GetTextureHandle(DrawCommand.TextureId);
+				// Get texture resource handle for this batch (null index will be also mapped to a valid texture).
+				const FSlateResourceHandle& Handle = ModuleManager->GetTextureManager().GetTextureHandle(Batch.TextureId);
 
 				// Transform clipping rectangle to screen space and apply to elements that we draw.
-				const FSlateRect ClippingRect = DrawCommand.ClippingRect.IntersectionWith(MyClippingRect);
-
-#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-				GSlateScissorRect = FShortRect{ ClippingRect };
-#else
-				OutDrawElements.PushClip(FSlateClippingZone{ ClippingRect });
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+				GSlateScissorRect = FShortRect{ Batch.ClippingRect.IntersectionWith(MyClippingRect) };
 
 				// Add elements to the list.
 				FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, Handle, VertexBuffer, IndexBuffer, nullptr, 0, 0);
-
-#if !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-				OutDrawElements.PopClip();
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 			}
 		}
+#else
+		// Let the context know which transform and culling rectangle to use when preparing the next frame on a worker
+		// thread.
+		ContextProxy->SetDrawTransform(ImGuiToScreen, MyClippingRect);
+
+		// If data were prepared for the same transform and culling rectangle, we only need to submit them. Otherwise,
+		// we convert draw lists here, unless they, the transform and the culling rectangle are the same as during the
+		// last conversion. Draw commands outside of the widget, like those of windows panned or zoomed out of view in
+		// the canvas control, are skipped during conversion.
+		const FImGuiSlateDrawData* DrawData = ContextProxy->GetPreparedDrawData();
+		if (!DrawData || !(DrawData->Transform == ImGuiToScreen) || !(DrawData->CullingRect == MyClippingRect))
+		{
+			if (!bHasSlateDrawData || SlateDrawDataVersion != ContextProxy->GetDrawDataVersion()
+				|| !(SlateDrawData.Transform == ImGuiToScreen) || !(SlateDrawData.CullingRect == MyClippingRect))
+			{
+				SCOPE_CYCLE_COUNTER(STAT_ImGuiConversion);
+				SlateDrawData.Prepare(ContextProxy->GetDrawData(), ImGuiToScreen, MyClippingRect);
+				ContextProxy->GetStats().AddTime(FImGuiContextStats::ETimer::Conversion, SlateDrawData.PrepareTime);
+				ContextProxy->GetStats().AddCount(FImGuiContextStats::ECounter::BytesConverted, SlateDrawData.NumBytesConverted);
+				ContextProxy->GetStats().AddCount(FImGuiContextStats::ECounter::CulledDrawCommands, SlateDrawData.NumCulledCommands);
+				SlateDrawDataVersion = ContextProxy->GetDrawDataVersion();
+				bHasSlateDrawData = true;
+			}
+#if IMGUI_WIDGET_DEBUG
+			else
+			{
+				RenderStats.bReused = true;
+			}
+#endif // IMGUI_WIDGET_DEBUG
+
+			DrawData = &SlateDrawData;
+		}
+#if IMGUI_WIDGET_DEBUG
+		else
+		{
+			RenderStats.bPrepared = true;
+		}
+#endif // IMGUI_WIDGET_DEBUG
+
+		for (int32 BatchNb = 0; BatchNb < DrawData->NumBatches; BatchNb++)
+		{
+			const FImGuiSlateBatch& Batch = DrawData->Batches[BatchNb];
+
+			// Get texture resource handle for this batch (null index will be also mapped to a valid texture).
+			const FSlateResourceHandle& Handle = ModuleManager->GetTextureManager().GetTextureHandle(Batch.TextureId);
+
+			// Clipping rectangle is already in screen space, so we only need to apply widget clipping.
+			OutDrawElements.PushClip(FSlateClippingZone{ Batch.ClippingRect.IntersectionWith(MyClippingRect) });
+
+			// Add elements to the list.
+			FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, Handle, Batch.Vertices, Batch.Indices, nullptr, 0, 0);
+
+			OutDrawElements.PopClip();
+		}
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 	}
 
 	return Super::OnPaint(Args, AllottedGeometry, MyClippingRect, OutDrawElements, LayerId, WidgetStyle, bParentEnabled);
@@ -726,6 +776,34 @@ namespace Styles
 	}
 }
 
+void SImGuiWidget::CollectRenderStats(TArrayView<const FImGuiDrawList> DrawLists, const FSlateRenderTransform& Transform, const FSlateRect& CullingRect) const
+{
+	RenderStats = {};
+	RenderStats.NumDrawLists = DrawLists.Num();
+
+	TArray<FImGuiDrawBatch> Batches;
+	for (const FImGuiDrawList& DrawList : DrawLists)
+	{
+		// Without batching, every non-empty command would be drawn with a copy of the whole vertex buffer.
+		for (int CommandNb = 0; CommandNb < DrawList.NumCommands(); CommandNb++)
+		{
+			const FImGuiDrawCommand DrawCommand = DrawList.GetCommand(CommandNb, Transform);
+			if (DrawCommand.NumElements > 0)
+			{
+				RenderStats.NumCommands++;
+				RenderStats.CommandBytes += DrawList.NumVertices() * sizeof(FSlateVertex) + DrawCommand.NumElements * sizeof(SlateIndex);
+			}
+		}
+
+		RenderStats.NumCulledCommands += DrawList.GetBatches(Batches, Transform, &CullingRect);
+		for (const FImGuiDrawBatch& Batch : Batches)
+		{
+			RenderStats.NumBatches++;
+			RenderStats.BatchBytes += Batch.NumVertices * sizeof(FSlateVertex) + Batch.NumIndices * sizeof(SlateIndex);
+		}
+	}
+}
+
 void SImGuiWidget::OnDebugDraw()
 {
 	FImGuiContextProxy* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex);
@@ -770,6 +848,21 @@ void SImGuiWidget::OnDebugDraw()
 				auto Widget = PreviousUserFocusedWidget.Pin();
 				TwoColumns::Value("Previous User Focused", Widget.IsValid() ? *Widget->GetTypeAsString() : TEXT("None"));
 			});
+
+			TwoColumns::CollapsingGroup("Rendering", [&]()
+			{
+				TwoColumns::Value("Draw Lists", RenderStats.NumDrawLists);
+				TwoColumns::Value("Draw Commands", RenderStats.NumCommands);
+				TwoColumns::Value("Culled Commands", RenderStats.NumCulledCommands);
+				TwoColumns::Value("Draw Elements", RenderStats.NumBatches);
+				TwoColumns::Value("Unbatched Bytes", RenderStats.CommandBytes);
+				TwoColumns::Value("Batched Bytes", RenderStats.BatchBytes);
+				TwoColumns::Value("Prepared On Worker", RenderStats.bPrepared);
+				TwoColumns::Value("Reused Unchanged", RenderStats.bReused);
+				TwoColumns::Value("Unchanged Frames", ContextProxy ? ContextProxy->GetNumUnchangedFrames() : 0u);
+				TwoColumns::Value("Cached Window Hits", ContextProxy ? ContextProxy->GetWindowCache().GetNumHits() : 0u);
+				TwoColumns::Value("Cached Window Misses", ContextProxy ? ContextProxy->GetWindowCache().GetNumMisses() : 0u);
+			});
 		}
 		ImGui::End();
 
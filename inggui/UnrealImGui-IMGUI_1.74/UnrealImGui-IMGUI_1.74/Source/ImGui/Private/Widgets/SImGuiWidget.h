@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ImGuiDrawData.h"
 #include "ImGuiModuleDebug.h"
 #include "ImGuiModuleSettings.h"
 
@@ -116,6 +117,7 @@ private:
 	void SetImGuiTransform(const FSlateRenderTransform& Transform) { ImGuiTransform = Transform; }
 
 #if IMGUI_WIDGET_DEBUG
+	void CollectRenderStats(TArrayView<const FImGuiDrawList> DrawLists, const FSlateRenderTransform& Transform, const FSlateRect& CullingRect) const;
 	void OnDebugDraw();
 #endif // IMGUI_WIDGET_DEBUG
 
@@ -126,8 +128,33 @@ private:
 	FSlateRenderTransform ImGuiTransform;
 	FSlateRenderTransform ImGuiRenderTransform;
 
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 	mutable TArray<FSlateVertex> VertexBuffer;
 	mutable TArray<SlateIndex> IndexBuffer;
+	mutable TArray<FImGuiDrawBatch> DrawBatches;
+#else
+	// Draw data converted during the last paint, reused if neither draw data nor transform changed.
+	mutable FImGuiSlateDrawData SlateDrawData;
+	mutable uint32 SlateDrawDataVersion = 0;
+	mutable bool bHasSlateDrawData = false;
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+
+#if IMGUI_WIDGET_DEBUG
+	// Statistics from the last paint, comparing batched submission with one element per draw command.
+	struct FRenderStats
+	{
+		int32 NumDrawLists = 0;
+		int32 NumCommands = 0;
+		int32 NumCulledCommands = 0;
+		int32 NumBatches = 0;
+		int32 CommandBytes = 0;
+		int32 BatchBytes = 0;
+		bool bPrepared = false;
+		bool bReused = false;
+	};
+
+	mutable FRenderStats RenderStats;
+#endif // IMGUI_WIDGET_DEBUG
 
 	int32 ContextIndex = 0;
 
@@ -100,6 +100,41 @@ public:
 	 */
 	virtual FImGuiTextureHandle RegisterTexture(const FName& Name, class UTexture2D* Texture, bool bMakeUnique = false);
 
+	/**
+	 * Register texture from pixels and create its Slate resources. Small textures are packed into shared atlas pages,
+	 * so many of them can be drawn with one draw call. Use texture coordinates from the returned handle (see
+	 * @ FImGuiTextureHandle::GetUV0 and GetUV1) to draw only the area of this texture. Throws exception, if name
+	 * argument is NAME_None or pixels are null.
+	 *
+	 * Note, that unlike with RegisterTexture, updating existing texture may change its handle, so handles to the old
+	 * texture should be replaced with the returned one.
+	 *
+	 * @param Name - Resource name for the texture that needs to be registered or updated
+	 * @param Width - Texture width
+	 * @param Height - Texture height
+	 * @param Pixels - Texture pixels, Width * Height values in rows (copied during this call)
+	 * @param bMakeUnique - If false then existing resources are replaced (default). If true, then stricter policy is
+	 *     applied and if resource with that name exists then exception is thrown.
+	 * @param bUseAtlas - If true (default), small textures are packed into the atlas. If false, texture is always
+	 *     created separately.
+	 * @returns Handle to the texture resources, which can be used to release allocated resources and as an argument to
+	 *     relevant ImGui functions
+	 */
+	virtual FImGuiTextureHandle RegisterTexture(const FName& Name, int32 Width, int32 Height, const FColor* Pixels, bool bMakeUnique = false, bool bUseAtlas = true);
+
+	/**
+	 * Update regions of a registered texture. Pixels are copied during this call and sent to the render thread together
+	 * with all other texture updates from this frame, in one render command at the end of the frame. Texture needs to be
+	 * in PF_B8G8R8A8 format, which is true for textures registered from pixels and for transient textures. If handle
+	 * is null or not valid, this function fails silently.
+	 *
+	 * @param Handle - Handle to the texture that needs to be updated
+	 * @param DirtyRects - Regions to update, in texture pixels
+	 * @param Pixels - Pixels of the whole texture, of which only dirty regions are read
+	 * @param PixelsPitch - Number of pixels in one row of Pixels (usually texture width)
+	 */
+	virtual void UpdateTexture(const FImGuiTextureHandle& Handle, TArrayView<const FIntRect> DirtyRects, const FColor* Pixels, int32 PixelsPitch);
+
 	/**
 	 * Unregister texture and release its Slate resources. If handle is null or not valid, this function fails silently
 	 * (for definition of 'valid' look @ FImGuiTextureHandle).
@@ -108,6 +143,45 @@ public:
 	 */
 	virtual void ReleaseTexture(const FImGuiTextureHandle& Handle);
 
+	/**
+	 * Begin an ImGui window with cached content. Use it in place of ImGui::Begin for windows whose content is expensive
+	 * to lay out but changes rarely. As long as content version, window size and scroll stay the same, draw output
+	 * from the last submission is re-emitted and content doesn't need to be submitted again. Must be always paired with
+	 * EndCachedWindow, regardless of the returned value.
+	 *
+	 * Re-emitted content is only drawn, its widgets are not submitted. While the cache is hit, widgets in the window
+	 * don't respond to input (no hovering, clicking or typing), so use it for content that is mostly read-only, or
+	 * change the content version when the mouse enters the window or it gains focus.
+	 *
+	 * @param Name - Window name, like in ImGui::Begin
+	 * @param ContentVersion - Version of window content that should be changed every time content changes
+	 * @param bOpen - Optional pointer to the window open state, like in ImGui::Begin
+	 * @param Flags - Window flags, like in ImGui::Begin
+	 * @returns True, if window content should be submitted and false, if window is collapsed or its content was
+	 *     re-emitted from cache
+	 */
+	virtual bool BeginCachedWindow(const char* Name, uint32 ContentVersion, bool* bOpen = nullptr, int Flags = 0);
+
+	/**
+	 * End an ImGui window started with BeginCachedWindow. Use it in place of ImGui::End.
+	 */
+	virtual void EndCachedWindow();
+
+	/**
+	 * Invalidate cached content of a window in the current ImGui context, so it needs to be submitted again.
+	 *
+	 * @param Name - Window name
+	 */
+	virtual void InvalidateCachedWindow(const char* Name);
+
+	/**
+	 * Get cache hit and miss counters for windows in the current ImGui context.
+	 *
+	 * @param OutHits - Number of times cached content was re-emitted
+	 * @param OutMisses - Number of times content needed to be submitted
+	 */
+	virtual void GetCachedWindowCounters(uint32& OutHits, uint32& OutMisses) const;
+
 	/**
 	 * Get ImGui module properties.
 	 *
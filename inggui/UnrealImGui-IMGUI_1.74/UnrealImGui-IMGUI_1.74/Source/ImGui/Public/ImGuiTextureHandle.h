@@ -41,6 +41,16 @@ public:
 	/** Get the ImGui texture id for this texture (invalid if handle is null). */
 	ImTextureID GetTextureId() const { return TextureId; }
 
+	/**
+	 * Get texture coordinates of the upper-left corner of this texture. For textures packed into an atlas it is a
+	 * position in the atlas page, which can change when the page is repacked, so it should be read every time the
+	 * texture is drawn.
+	 */
+	ImVec2 GetUV0() const;
+
+	/** Get texture coordinates of the lower-right corner of this texture (see @ GetUV0). */
+	ImVec2 GetUV1() const;
+
 	/** Implicit conversion to ImTextureID. */
 	operator ImTextureID() const { return GetTextureId(); }
 